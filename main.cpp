@@ -2,11 +2,30 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
+#include <map>
+#include <deque>
+#include <queue>
+#include <set>
+#include <thread>
 #include "vl_vector.h"
 #include "helpers.h"
 
 #ifdef BONUS_IMPLEMENTED
 # include "vl_string.h"
+# include "vl_string_interner.h"
+# include "vl_rope.h"
+# include "vl_fixed_string.h"
+# include "vl_flat_map.h"
+# include "vl_hash_map.h"
+# include "vl_ring_buffer.h"
+# include "vl_bit_vector.h"
+# include "vl_soa_vector.h"
+# include "vl_stable_vector.h"
+# include "vl_priority_queue.h"
+# include "vl_slot_map.h"
+# include "vl_jagged_vector.h"
+# include "vl_sparse_set.h"
 #endif
 
 #define PRESUBMISSION_ASSERT(testCase) __ASSERT_TEST("Presubmit", testCase)
@@ -246,6 +265,994 @@ int TestVLStringConcat() {
     return 1;
 }
 
+int TestVLStringHash() {
+    std::unordered_map<VLString<>, int> map;
+    map[VLString<>("alpha")] = 1;
+    map[VLString<>("a much longer identifier that lives on the heap")] = 2;
+    ASSERT_TRUE(map.find(VLString<>("alpha")) != map.end() && map[VLString<>("alpha")] == 1)
+    ASSERT_TRUE(map[VLString<>("a much longer identifier that lives on the heap")] == 2)
+    ASSERT_TRUE(map.find(VLString<>("beta")) == map.end())
+
+    VLHashedString<> hashed("tenant");
+    ASSERT_TRUE(hashed.Hash() == std::hash<VLString<>>()(VLString<>("tenant")))
+    hashed.PushBack('s');
+    ASSERT_TRUE(hashed.Hash() == std::hash<VLString<>>()(VLString<>("tenants")))
+    hashed[0] = 'T';
+    ASSERT_TRUE(hashed.Hash() == std::hash<VLString<>>()(VLString<>("Tenants")))
+    hashed.Append(VLStringView("_01"));
+    ASSERT_TRUE(hashed.Hash() == std::hash<VLString<>>()(VLString<>("Tenants_01")))
+    hashed.ToLowerAscii();
+    ASSERT_TRUE(hashed.Hash() == std::hash<VLString<>>()(VLString<>("tenants_01")))
+    hashed.Replace(0, 7, VLStringView("user"));
+    ASSERT_TRUE(hashed.Hash() == std::hash<VLString<>>()(VLString<>("user_01")))
+    hashed.AppendInt(7);
+    ASSERT_TRUE(hashed.Hash() == std::hash<VLString<>>()(VLString<>("user_017")))
+
+    std::vector<int> values{1, 2, 3};
+    VLVector<int> vec1(values.begin(), values.end());
+    VLVector<int> vec2(values.begin(), values.end());
+    RETURN_ASSERT_TRUE(std::hash<VLVector<int>>()(vec1) == std::hash<VLVector<int>>()(vec2))
+}
+
+int TestVLStringInterner() {
+    VLStringInterner interner;
+    VLStringInterner::Handle alpha = interner.Intern("alpha");
+    VLStringView alpha_view = interner.View(alpha);
+    ASSERT_TRUE(interner.Intern(VLString<>("alpha")) == alpha)
+    ASSERT_TRUE(interner.Intern("beta") != alpha)
+    ASSERT_TRUE(interner.Find("gamma") == INTERNER_NO_HANDLE)
+
+    // enough strings to grow the table and fill several arena blocks
+    for (int i = 0; i < 2000; ++i) {
+        VLString<> str("id_");
+        str.PushBack((char) ('a' + i % 26));
+        str.PushBack((char) ('a' + i / 26 % 26));
+        str.PushBack((char) ('a' + i / 676));
+        interner.Intern(str);
+    }
+    ASSERT_TRUE(interner.Size() == 2002)
+    ASSERT_TRUE(interner.View(alpha).Data() == alpha_view.Data() && interner.View(alpha) == VLStringView("alpha"))
+    ASSERT_TRUE(strcmp(interner.CStr(interner.Find("id_abc")), "id_abc") == 0)
+
+    VLShardedStringInterner<> sharded;
+    VLShardedStringInterner<>::Handle tenant = sharded.Intern("tenant");
+    ASSERT_TRUE(sharded.Intern("tenant") == tenant && sharded.Find("tenant") == tenant)
+    ASSERT_TRUE(sharded.Intern("other") != tenant)
+    RETURN_ASSERT_TRUE(sharded.View(tenant) == VLStringView("tenant") && sharded.Size() == 2)
+}
+
+int TestVLStringNumbers() {
+    VLString<> str;
+    str.AppendInt(-42);
+    str += ',';
+    str.AppendUInt(18446744073709551615ULL);
+    ASSERT_TRUE(strcmp(str.Data(), "-42,18446744073709551615") == 0)
+
+    VLString<> small;
+    small.AppendInt(1234567);
+    small.PushBack(' ');
+    small.AppendHex(255);
+    small.PushBack(' ');
+    small.AppendDouble(0.1);
+    ASSERT_TRUE(strcmp(small.Data(), "1234567 ff 0.1") == 0)
+    ASSERT_CAPACITY(small, STATIC_CAP)
+
+    VLString<> min_str;
+    min_str.AppendInt(LLONG_MIN);
+    long long parsed_int = 0;
+    ASSERT_TRUE(min_str.ParseInt(parsed_int) && parsed_int == LLONG_MIN)
+    ASSERT_TRUE(!VLString<>("9223372036854775808").ParseInt(parsed_int))
+    ASSERT_TRUE(!VLString<>("12a").ParseInt(parsed_int) && !VLString<>("").ParseInt(parsed_int))
+
+    double values[] = {1.0 / 3, 1e300, -2.5e-300, 123456789.125};
+    for (double value : values) {
+        VLString<> num;
+        num.AppendDouble(value);
+        double parsed = 0;
+        ASSERT_TRUE(num.ParseDouble(parsed) && parsed == value)
+    }
+    double parsed = 0;
+    VLString<> popped("12");
+    popped.PopBack();
+    ASSERT_TRUE(popped.ParseDouble(parsed) && parsed == 1.0)
+    ASSERT_TRUE(popped.ParseInt(parsed_int) && parsed_int == 1)
+    RETURN_ASSERT_TRUE(!VLString<>(" 1.5").ParseDouble(parsed) && !VLString<>("1.5x").ParseDouble(parsed))
+}
+
+int TestVLStringFormat() {
+    VLString<64> message = VLString<64>::Format("{}:{} {{{}}} {:x}", "host", 8080, true, 255u);
+    ASSERT_TRUE(strcmp(message.Data(), "host:8080 {true} ff") == 0)
+    ASSERT_CAPACITY(message, 64)
+    VLString<16> ratio = VLString<16>::Format("x={}", 1.5);
+    ASSERT_TRUE(ratio == "x=1.5")
+    ASSERT_CAPACITY(ratio, 16)
+    VLString<64> triple = VLString<64>::Format("{} {} {}", 1.0, 2.0, 3.0);
+    ASSERT_TRUE(triple == "1 2 3")
+    ASSERT_CAPACITY(triple, 64)
+
+    VLString<> name("tenant");
+    VLString<> out("id=");
+    VLString<>::FormatTo(out, "{}/{}/{}/{}", name, -7, 'c', 2.5);
+    ASSERT_TRUE(strcmp(out.Data(), "id=tenant/-7/c/2.5") == 0)
+    VLString<>::FormatTo(out, "{}{}", out, 1); // out grows while being read
+    ASSERT_TRUE(strcmp(out.Data(), "id=tenant/-7/c/2.5id=tenant/-7/c/2.51") == 0)
+    VLString<> pattern("<{}> <{}> <{}> <{}>");
+    VLString<>::FormatTo(pattern, pattern, 1, 2, 3, 4);
+    ASSERT_TRUE(strcmp(pattern.Data(), "<{}> <{}> <{}> <{}><1> <2> <3> <4>") == 0)
+
+    ASSERT_THROWING(VLString<>::Format("{} {}", 1);)
+    ASSERT_THROWING(VLString<>::Format("{", 1);)
+    return 1;
+}
+
+int TestVLStringAscii() {
+    VLString<> key("  Content-Type: TEXT/Html; Charset=UTF-8 \r\n");
+    ASSERT_TRUE(key.TrimBoth() == VLStringView("Content-Type: TEXT/Html; Charset=UTF-8"))
+    ASSERT_TRUE(key.TrimLeft().Data() == key.Data() + 2)
+    ASSERT_TRUE(key.TrimRight().Size() == key.Size() - 3)
+    ASSERT_TRUE(VLString<>("         ").TrimBoth().Empty())
+
+    key.ToLowerAscii();
+    ASSERT_TRUE(key.TrimBoth() == VLStringView("content-type: text/html; charset=utf-8"))
+    key.ToUpperAscii();
+    ASSERT_TRUE(key.TrimBoth() == VLStringView("CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8"))
+
+    VLString<> header("X-Forwarded-For");
+    ASSERT_TRUE(header.EqualsIgnoreCaseAscii("x-forwarded-for"))
+    ASSERT_TRUE(!header.EqualsIgnoreCaseAscii("x-forwarded-fo@"))
+    RETURN_ASSERT_TRUE(!header.EqualsIgnoreCaseAscii("x-forwarded-fo"))
+}
+
+int TestVLStringUtf8() {
+    // "naïve café, 日本, 😀" followed by enough ascii to take the 16 byte path
+    VLString<> text("na\xc3\xafve caf\xc3\xa9, \xe6\x97\xa5\xe6\x9c\xac, \xf0\x9f\x98\x80 and some plain ascii");
+    ASSERT_TRUE(text.IsValidUtf8())
+    ASSERT_TRUE(text.CodePointCount() == 38)
+
+    char32_t expected[] = {'n', 'a', 0xef, 'v', 'e', ' ', 'c', 'a', 'f', 0xe9, ',', ' ', 0x65e5, 0x672c, ',', ' ', 0x1f600};
+    size_t ix = 0;
+    for (char32_t code_point : text.CodePoints()) {
+        if (ix < sizeof(expected) / sizeof(expected[0])) {
+            ASSERT_TRUE(code_point == expected[ix])
+        }
+        ix++;
+    }
+    ASSERT_TRUE(ix == 38)
+
+    ASSERT_TRUE(!VLString<>("\xc0\xaf").IsValidUtf8())             // overlong '/'
+    ASSERT_TRUE(!VLString<>("\xed\xa0\x80").IsValidUtf8())         // surrogate
+    ASSERT_TRUE(!VLString<>("\xf4\x90\x80\x80").IsValidUtf8())     // above U+10FFFF
+    ASSERT_TRUE(!VLString<>("abc\xe6\x97").IsValidUtf8())           // cut short
+    RETURN_ASSERT_TRUE(*VLString<>("\xff!").CodePoints().begin() == UTF8_REPLACEMENT)
+}
+
+int TestVLStringCompare() {
+    VLString<> apple("apple");
+    VLString<> apples("apples");
+    VLString<> banana("banana");
+    ASSERT_TRUE(apple < apples && apples < banana && !(banana < apple))
+    ASSERT_TRUE(apple.Compare(apples) < 0 && banana.Compare("apple") > 0 && apple.Compare("apple") == 0)
+    ASSERT_TRUE(apple == "apple" && "apple" == apple && apple != "apples")
+    ASSERT_TRUE(apple <= "apple" && "b" > apples && apples >= VLStringView("apple"))
+
+    VLString<> route("/api/v1/users");
+    ASSERT_TRUE(route.StartsWith("/api/") && !route.StartsWith("/apx"))
+    ASSERT_TRUE(route.EndsWith("users") && !route.EndsWith("/api/v1/users/") && route.EndsWith(""))
+
+    std::map<VLString<>, int> sorted;
+    sorted[banana] = 2;
+    sorted[apples] = 1;
+    sorted[apple] = 0;
+    int expected = 0;
+    for (const auto &entry : sorted) {
+        ASSERT_TRUE(entry.second == expected++)
+    }
+    return 1;
+}
+
+int TestVLCowString() {
+    VLCowString<> config("a configuration value long enough to live on the heap");
+    VLCowString<> copy1(config);
+    VLCowString<> copy2;
+    copy2 = copy1;
+    ASSERT_TRUE(copy1.Data() == config.Data() && copy2.Data() == config.Data())
+    ASSERT_TRUE(config.IsShared() && copy1 == config)
+
+    copy1.PushBack('!');
+    ASSERT_TRUE(copy1.Data() != config.Data() && !copy1.IsShared())
+    ASSERT_TRUE(copy1.EndsWith("heap!") && config.EndsWith("heap") && copy2 == config)
+
+    copy2[0] = 'A';
+    ASSERT_TRUE(copy2.StartsWith("A config") && config.StartsWith("a config") && !config.IsShared())
+
+    config.Clear();
+    ASSERT_TRUE(config.Empty() && copy2.Size() == 53)
+
+    VLCowString<> short_str("short");
+    VLCowString<> short_copy(short_str);
+    ASSERT_TRUE(short_copy.Data() != short_str.Data() && short_copy == short_str)
+    ASSERT_CAPACITY(short_copy, STATIC_CAP)
+
+    // the first copies of a const string race to attach its reference count
+    const VLCowString<> source("a string copied from several threads at once, on the heap");
+    std::vector<VLCowString<>> copies(4);
+    std::vector<std::thread> threads;
+    for (size_t ix = 0 ; ix < copies.size() ; ix++){
+        threads.emplace_back([&source, &copies, ix]() { copies[ix] = source; });
+    }
+    for (std::thread &thread : threads){
+        thread.join();
+    }
+    for (const VLCowString<> &copy : copies){
+        ASSERT_TRUE(copy.Data() == source.Data() && copy == source)
+    }
+    copies.clear();
+    ASSERT_TRUE(!source.IsShared())
+
+    VLString<> plain("another string that is long enough for the heap");
+    VLString<> plain_copy(plain);
+    RETURN_ASSERT_TRUE(plain_copy == plain && plain_copy.Capacity() == 72) // 1.5 * (47 chars + \0)
+}
+
+int TestVLRope() {
+    std::string model(3000, 'x');
+    VLRope rope(VLStringView(model.data(), model.size()));
+    ASSERT_TRUE(rope.Size() == 3000 && rope.ChunkCount() == 6)
+
+    // a deterministic mix of inserts and erases checked against std::string
+    unsigned int state = 12345;
+    for (int i = 0; i < 500; ++i) {
+        state = state * 1103515245 + 12345;
+        size_t pos = (state >> 8) % (model.size() + 1);
+        if (i % 3 == 2) {
+            size_t len = (state >> 4) % 700;
+            rope.Erase(pos, len);
+            model.erase(pos, len);
+        } else {
+            std::string text(1 + (state >> 12) % (i % 5 == 0 ? 900 : 20), (char) ('a' + i % 26));
+            rope.Insert(pos, VLStringView(text.data(), text.size()));
+            model.insert(pos, text);
+        }
+    }
+    ASSERT_TRUE(rope.Size() == model.size())
+    VLString<> flat = rope.ToVLString();
+    ASSERT_TRUE(flat == VLStringView(model.data(), model.size()))
+    ASSERT_TRUE(rope.At(model.size() / 2) == model[model.size() / 2])
+
+    VLRope tail = rope.Split(100);
+    ASSERT_TRUE(rope.Size() == 100 && tail.Size() == model.size() - 100)
+    ASSERT_TRUE(tail.ToVLString() == VLStringView(model.data() + 100, model.size() - 100))
+    rope.Concat(tail);
+    ASSERT_TRUE(tail.Empty() && rope.ToVLString() == VLStringView(model.data(), model.size()))
+
+    size_t chunk_bytes = 0;
+    rope.ForEachChunk([&chunk_bytes](const VLStringView chunk) { chunk_bytes += chunk.Size(); });
+    ASSERT_TRUE(chunk_bytes == model.size())
+    ASSERT_THROWING(rope.Insert(model.size() + 1, "x");)
+
+    VLRope shrinking(VLStringView(std::string(3000, 'y').c_str()));
+    shrinking.Erase(100, 2800); // the two 100 char ends fit in one chunk again
+    ASSERT_TRUE(shrinking.Size() == 200 && shrinking.ChunkCount() == 1)
+    for (int i = 0; i < 190; ++i) {
+        shrinking.Erase(0, 1);
+    }
+    ASSERT_TRUE(shrinking.Size() == 10 && shrinking.ChunkCount() == 1)
+    return 1;
+}
+
+int TestVLStringEdit() {
+    VLString<> str("Hello World");
+    str.Insert(5, ",");
+    str.Insert(str.Size(), "!");
+    ASSERT_TRUE(str == "Hello, World!")
+    str.Replace(7, 5, "there, a much longer name");
+    ASSERT_TRUE(str == "Hello, there, a much longer name!" && str.Data()[str.Size()] == '\0')
+    str.Erase(5, 100);
+    ASSERT_TRUE(str == "Hello" && str.Data()[5] == '\0')
+    ASSERT_CAPACITY(str, STATIC_CAP)
+    str.Insert(0, str.View());
+    ASSERT_TRUE(str == "HelloHello")
+    ASSERT_THROWING(str.Erase(11, 1);)
+
+    VLString<> tmpl("Dear {name}, your order {id} for {name} is ready");
+    ASSERT_TRUE(tmpl.Find("{name}") == 5 && tmpl.Find("{name}", 6) == 33 && tmpl.Find("{none}") == NOT_FOUND)
+    ASSERT_TRUE(tmpl.ReplaceAll("{name}", "Alexandra Smith") == 2)
+    ASSERT_TRUE(tmpl.ReplaceAll("{id}", "#7") == 1)
+    ASSERT_TRUE(tmpl == "Dear Alexandra Smith, your order #7 for Alexandra Smith is ready")
+    ASSERT_TRUE(tmpl.ReplaceAll("Alexandra Smith", "A") == 2)
+    ASSERT_TRUE(tmpl == "Dear A, your order #7 for A is ready")
+    RETURN_ASSERT_TRUE(tmpl.ReplaceAll("", "x") == 0 && tmpl.ReplaceAll("zzz", "x") == 0)
+}
+
+int TestVLBasicString() {
+    VLU16String<> wide(u"caf\u00e9");
+    ASSERT_TRUE(wide.Size() == 4 && wide.Capacity() == STATIC_CAP / 2)
+    wide += u" au lait, caf\u00e9 noir";
+    ASSERT_TRUE(wide == u"caf\u00e9 au lait, caf\u00e9 noir" && wide.Data()[wide.Size()] == 0)
+    ASSERT_TRUE(wide.Find(u"caf\u00e9", 1) == 14 && wide.StartsWith(u"caf") && wide.EndsWith(u"noir"))
+    ASSERT_TRUE(wide.ReplaceAll(u"caf\u00e9", u"tea") == 2 && wide == u"tea au lait, tea noir")
+    wide.Erase(3, 8);
+    ASSERT_TRUE(wide == u"tea, tea noir" && wide < u"tea,!" && u"tea" < wide)
+    ASSERT_TRUE(std::hash<VLU16String<>>()(wide) == std::hash<VLU16StringView>()(u"tea, tea noir"))
+
+    VLU32String<> code_points(U"\U0001F600 smile");
+    ASSERT_TRUE(code_points.Size() == 7 && code_points.Capacity() > STATIC_CAP / 4)
+    code_points.Insert(0, U"\u65e5");
+    ASSERT_TRUE(code_points[0] == 0x65e5 && code_points[1] == 0x1f600)
+    RETURN_ASSERT_TRUE(code_points.View().Compare(U"\u65e5\U0001F600 smile") == 0)
+}
+
+int TestVLStringEscape() {
+    // walking a mask lowest bit first visits the bytes in memory order on little endian
+    // and backwards on big endian, either way each byte exactly once
+    const unsigned char marks[8] = {0, 0x80, 0, 0, 0, 0x80, 0, 0x80};
+    uint64_t mask = SwarLoad(marks);
+    size_t visited = 0;
+    for (; mask ; mask &= mask - 1){
+        visited |= (size_t) 1 << SwarLowestByte(mask);
+    }
+    ASSERT_TRUE(visited == ((1 << 1) | (1 << 5) | (1 << 7)))
+
+    VLString<> json;
+    json.AppendJsonEscaped("a plain field without anything to escape");
+    ASSERT_TRUE(json == "a plain field without anything to escape")
+
+    VLString<> escaped;
+    escaped.AppendJsonEscaped("say \"hi\"\tto C:\\path\nnow\x01 and a longer clean tail");
+    ASSERT_TRUE(escaped == "say \\\"hi\\\"\\tto C:\\\\path\\nnow\\u0001 and a longer clean tail")
+    VLString<> round_trip;
+    ASSERT_TRUE(round_trip.AppendJsonUnescaped(escaped))
+    ASSERT_TRUE(round_trip == "say \"hi\"\tto C:\\path\nnow\x01 and a longer clean tail")
+
+    VLString<> unicode;
+    ASSERT_TRUE(unicode.AppendJsonUnescaped("caf\\u00e9 \\ud83d\\ude00"))
+    ASSERT_TRUE(unicode == "caf\xc3\xa9 \xf0\x9f\x98\x80")
+    ASSERT_TRUE(!unicode.AppendJsonUnescaped("bad \\x escape") && !unicode.AppendJsonUnescaped("\\ud83d alone"))
+    ASSERT_TRUE(unicode == "caf\xc3\xa9 \xf0\x9f\x98\x80")
+
+    VLString<> csv;
+    csv.AppendCsvQuoted("plain");
+    csv.PushBack(',');
+    csv.AppendCsvQuoted("has, comma and \"quotes\"");
+    ASSERT_TRUE(csv == "plain,\"has, comma and \"\"quotes\"\"\"")
+
+    VLString<> field;
+    ASSERT_TRUE(field.AppendCsvUnquoted("\"has, comma and \"\"quotes\"\"\""))
+    ASSERT_TRUE(field == "has, comma and \"quotes\"")
+    ASSERT_TRUE(!field.AppendCsvUnquoted("\"lone \" quote\"") && !field.AppendCsvUnquoted("\"open"))
+
+    // appending a string to itself, the growth moves the buffer being read
+    VLString<> self_json("say \"hi\" from a string long enough to live on the heap");
+    VLString<> expected(self_json);
+    expected.AppendJsonEscaped(VLStringView("say \"hi\" from a string long enough to live on the heap"));
+    self_json.AppendJsonEscaped(self_json);
+    ASSERT_TRUE(self_json == expected)
+    VLString<> self_escaped(escaped);
+    ASSERT_TRUE(self_escaped.AppendJsonUnescaped(self_escaped))
+    ASSERT_TRUE(self_escaped == escaped + round_trip)
+    VLString<> self_csv("has, comma and \"quotes\" and a tail for the heap");
+    expected = self_csv;
+    expected.AppendCsvQuoted(VLStringView("has, comma and \"quotes\" and a tail for the heap"));
+    self_csv.AppendCsvQuoted(self_csv);
+    ASSERT_TRUE(self_csv == expected)
+    VLString<> self_field("\"has, comma and \"\"quotes\"\" and a tail for the heap\"");
+    ASSERT_TRUE(self_field.AppendCsvUnquoted(self_field))
+    RETURN_ASSERT_TRUE(self_field == "\"has, comma and \"\"quotes\"\" and a tail for the heap\""
+                                    "has, comma and \"quotes\" and a tail for the heap")
+}
+
+int TestVLStringCodec() {
+    const uint8_t raw[] = {0x00, 0x01, 0x7f, 0x80, 0xfe, 0xff, 'h', 'i'};
+    VLVector<uint8_t> payload(raw, raw + sizeof(raw));
+
+    VLString<> hex;
+    hex.AppendHex(payload);
+    ASSERT_TRUE(hex == "00017f80feff6869")
+    VLVector<uint8_t> from_hex;
+    ASSERT_TRUE(hex.DecodeHex(from_hex) && from_hex.Size() == sizeof(raw))
+    ASSERT_TRUE(memcmp(from_hex.Data(), raw, sizeof(raw)) == 0)
+    ASSERT_TRUE(!VLString<>("0A1").DecodeHex(from_hex) && !VLString<>("0g").DecodeHex(from_hex))
+    ASSERT_TRUE(VLString<>("0A").DecodeHex(from_hex) && from_hex.Size() == sizeof(raw) + 1 && from_hex[8] == 0x0a)
+
+    const char *expected[] = {"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"};
+    for (size_t len = 0 ; len <= 6 ; len++){
+        VLString<> encoded;
+        encoded.AppendBase64((const uint8_t*) "foobar", len);
+        ASSERT_TRUE(encoded == expected[len])
+        VLVector<uint8_t> decoded;
+        ASSERT_TRUE(encoded.DecodeBase64(decoded) && decoded.Size() == len)
+        ASSERT_TRUE(memcmp(decoded.Data(), "foobar", len) == 0)
+    }
+
+    VLString<> b64;
+    b64.AppendBase64(payload);
+    VLVector<uint8_t> from_b64;
+    ASSERT_TRUE(b64 == "AAF/gP7/aGk=" && b64.DecodeBase64(from_b64))
+    ASSERT_TRUE(from_b64.Size() == sizeof(raw) && memcmp(from_b64.Data(), raw, sizeof(raw)) == 0)
+
+    VLVector<uint8_t> lenient;
+    ASSERT_TRUE(!VLString<>("Zm9v\nYmE").DecodeBase64(lenient) && lenient.Empty())
+    ASSERT_TRUE(!VLString<>("Zh==").DecodeBase64(lenient) && !VLString<>("Zg=a").DecodeBase64(lenient))
+    ASSERT_TRUE(VLString<>("Zm9v\r\nYmE").DecodeBase64(lenient, true) && lenient.Size() == 5)
+    RETURN_ASSERT_TRUE(!VLString<>("Zm9vY").DecodeBase64(lenient, true) && lenient.Size() == 5)
+}
+
+int TestVLFixedString() {
+    static_assert(std::is_trivially_copyable<VLFixedString<15>>::value, "VLFixedString must be trivially copyable");
+    static_assert(sizeof(VLFixedString<15>) == 16 && sizeof(VLFixedString<24>) == 32, "VLFixedString is whole words");
+
+    VLFixedString<15> symbol("AAPL.NASDAQ");
+    ASSERT_TRUE(symbol.Size() == 11 && symbol.View() == "AAPL.NASDAQ" && strcmp(symbol.CStr(), "AAPL.NASDAQ") == 0)
+    symbol.Append(".OTC");
+    ASSERT_TRUE(symbol.Size() == 15 && strlen(symbol.CStr()) == 15) // full, the spare count doubles as the \0
+    ASSERT_THROWING(symbol.PushBack('X');)
+    ASSERT_THROWING(symbol.At(15);)
+    ASSERT_TRUE(symbol.Size() == 15)
+    symbol.PopBack();
+    ASSERT_TRUE(symbol == VLFixedString<15>("AAPL.NASDAQ.OT") && symbol != VLFixedString<15>("AAPL.NASDAQ.OX"))
+    ASSERT_TRUE(VLFixedString<15>("AB") < VLFixedString<15>("ABC") && VLFixedString<15>("ABC").Compare(VLStringView("ABD")) < 0)
+
+    VLFixedString<15> copy;
+    memcpy(&copy, &symbol, sizeof(copy));
+    ASSERT_TRUE(copy == symbol && copy.Hash() == symbol.Hash())
+
+    VLVector<VLFixedString<24>, 4> ids;
+    for (int ix = 0 ; ix < 20 ; ix++){
+        VLFixedString<24> id("order-");
+        id.PushBack((char) ('a' + ix));
+        ids.PushBack(id); // spills to the heap through the memcpy DataCopy
+    }
+    VLVector<VLFixedString<24>, 4> ids_copy(ids);
+    ASSERT_TRUE(ids_copy.Size() == 20 && ids_copy[19].View() == "order-t")
+    typedef std::hash<VLVector<VLFixedString<24>, 4>> IdsHash;
+    ASSERT_TRUE(IdsHash()(ids) == IdsHash()(ids_copy))
+
+    std::unordered_map<VLFixedString<15>, int> prices;
+    prices[VLFixedString<15>("MSFT")] = 410;
+    prices[VLFixedString<15>("AAPL")] = 190;
+    RETURN_ASSERT_TRUE(prices.size() == 2 && prices[VLFixedString<15>("MSFT")] == 410)
+}
+
+int TestVLStringBuf() {
+    VLStringBuf<STATIC_CAP> buf;
+    for (int ix = 0 ; ix < STATIC_CAP ; ix++){
+        buf.PushBack((char) ('a' + ix));
+    }
+    ASSERT_SIZE(buf, STATIC_CAP)
+    ASSERT_CAPACITY(buf, STATIC_CAP) // every inline char holds text, no \0 slot
+    ASSERT_TRUE(buf == "abcdefghijklmnop")
+    ASSERT_TRUE(strcmp(buf.CStr(), "abcdefghijklmnop") == 0 && buf.Size() == STATIC_CAP)
+
+    buf += buf.View(); // appending from itself across the heap spill
+    buf += '!';
+    ASSERT_TRUE(buf.Size() == 2 * STATIC_CAP + 1 && buf == "abcdefghijklmnopabcdefghijklmnop!")
+    ASSERT_TRUE(strcmp(buf.CStr(), "abcdefghijklmnopabcdefghijklmnop!") == 0)
+
+    VLString<> copy = buf.ToVLString();
+    ASSERT_TRUE(copy.Size() == buf.Size() && copy.Hash() == buf.Hash())
+
+    while (buf.Size() > 3){
+        buf.PopBack();
+    }
+    ASSERT_TRUE(buf == "abc" && strcmp(buf.CStr(), "abc") == 0)
+    buf.Clear();
+    RETURN_ASSERT_TRUE(buf.Empty() && strcmp(buf.CStr(), "") == 0)
+}
+
+int TestVLFlatMap() {
+    VLFlatMap<int, VLString<>> small;
+    ASSERT_TRUE(small.Insert(3, VLString<>("three")) && small.Insert(1, VLString<>("one")))
+    ASSERT_TRUE(!small.Insert(3, VLString<>("again")) && *small.Find(3) == "three")
+    small[2] = VLString<>("two");
+    ASSERT_TRUE(small.Size() == 3 && small.KeyAt(0) == 1 && small.KeyAt(2) == 3 && small.Find(4) == nullptr)
+    ASSERT_TRUE(!small.InsertOrAssign(1, VLString<>("uno")) && small.ValueAt(0) == "uno")
+    ASSERT_TRUE(small.Erase(2) && !small.Erase(2) && small.Size() == 2 && small.Keys().Capacity() == STATIC_CAP)
+
+    // the value comes from the map itself and the insert moves its storage
+    VLFlatMap<int, int, 2> tiny;
+    for (int key = 10 ; key <= 40 ; key += 10){
+        tiny.Insert(key, key * 2);
+    }
+    ASSERT_TRUE(tiny.InsertOrAssign(5, tiny.ValueAt(0)) && tiny.ValueAt(0) == 20 && tiny.ValueAt(1) == 20)
+
+    // past the linear threshold, checked against std::map
+    VLFlatMap<int, int, 8> big;
+    std::map<int, int> reference;
+    for (int ix = 0 ; ix < 500 ; ix++){
+        int key = (ix * 7919) % 1009;
+        ASSERT_TRUE(big.Insert(key, ix) == reference.insert(std::make_pair(key, ix)).second)
+    }
+    std::vector<std::pair<int, int>> batch;
+    for (int ix = 0 ; ix < 300 ; ix++){
+        batch.push_back(std::make_pair((ix * 31) % 1200, -ix));
+    }
+    big.InsertRange(batch.begin(), batch.end());
+    reference.insert(batch.begin(), batch.end());
+    ASSERT_TRUE(big.Size() == reference.size())
+    size_t ix = 0;
+    for (const auto &entry : reference){
+        ASSERT_TRUE(big.KeyAt(ix) == entry.first && big.ValueAt(ix) == entry.second)
+        ix++;
+    }
+    for (int key = -5 ; key < 1300 ; key += 3){
+        ASSERT_TRUE(big.Contains(key) == (reference.count(key) == 1))
+    }
+
+    VLFlatSet<int> set;
+    int values[] = {5, 1, 5, 9, 3, 1};
+    set.InsertRange(values, values + 6);
+    ASSERT_TRUE(set.Size() == 4 && set.At(0) == 1 && set.At(3) == 9 && !set.Insert(9) && set.Insert(4))
+    RETURN_ASSERT_TRUE(set.Erase(1) && set.At(0) == 3 && set.At(1) == 4 && set.Contains(5) && !set.Contains(1))
+}
+
+int TestVLHashMap() {
+    VLHashMap<int, int> small;
+    for (int ix = 0 ; ix < 14 ; ix++){
+        ASSERT_TRUE(small.Insert(ix * 3, ix))
+    }
+    ASSERT_TRUE(small.Capacity() == STATIC_CAP && small.Size() == 14) // 7/8 of the inline slots, no allocation
+    ASSERT_TRUE(!small.Insert(9, 100) && *small.Find(9) == 3 && small.Find(10) == nullptr)
+    small[100] = 7;
+    ASSERT_TRUE(small.Capacity() == 2 * STATIC_CAP && *small.Find(100) == 7 && *small.Find(39) == 13)
+
+    // random inserts and erases against std::unordered_map, erase must keep every probe run reachable
+    VLHashMap<int, int, 8> map;
+    std::unordered_map<int, int> reference;
+    unsigned seed = 12345;
+    for (int step = 0 ; step < 20000 ; step++){
+        seed = seed * 1103515245 + 12345;
+        int key = (int) ((seed >> 8) % 700);
+        if ((seed >> 4) % 3 == 0){
+            ASSERT_TRUE(map.Erase(key) == (reference.erase(key) == 1))
+        } else {
+            ASSERT_TRUE(map.InsertOrAssign(key, step) == (reference.count(key) == 0))
+            reference[key] = step;
+        }
+    }
+    ASSERT_TRUE(map.Size() == reference.size())
+    for (int key = 0 ; key < 700 ; key++){
+        const int *value = map.Find(key);
+        ASSERT_TRUE(reference.count(key) ? value && *value == reference[key] : value == nullptr)
+    }
+    size_t visited = 0;
+    map.ForEach([&visited](const int&, int&) { visited++; });
+    VLHashMap<int, int, 8> copy(map);
+    ASSERT_TRUE(visited == reference.size() && copy.Size() == map.Size() && copy.Contains(reference.begin()->first))
+
+    // key and value taken from the map itself while the insert rehashes it, inline -> heap -> heap
+    typedef VLHashMap<VLString<>, VLString<>, 8, VLStringHash, VLStringEqual> AliasMap;
+    AliasMap names;
+    for (int ix = 0 ; ix < 7 ; ix++){
+        VLString<> key("name_");
+        key.AppendInt(ix);
+        VLString<> value("a value long enough for the heap, number ");
+        value.AppendInt(ix);
+        names.Insert(key, value);
+    }
+    ASSERT_TRUE(names.Capacity() == 8)
+    VLString<> expected(*names.Find("name_3"));
+    ASSERT_TRUE(names.InsertOrAssign(VLString<>("moved_0"), *names.Find("name_3")) && names.Capacity() == 16)
+    ASSERT_TRUE(*names.Find("moved_0") == expected)
+    for (int ix = 1 ; names.Size() < 14 ; ix++){
+        VLString<> key("moved_");
+        key.AppendInt(ix);
+        names.Insert(key, expected);
+    }
+    VLString<> second(*names.Find("name_2"));
+    ASSERT_TRUE(names.Insert(*names.Find("name_3"), *names.Find("name_2")) && names.Capacity() == 32)
+    ASSERT_TRUE(*names.Find(expected) == second && names.Size() == 15)
+
+    VLHashMap<VLString<>, int, 8, VLStringHash, VLStringEqual> attributes;
+    attributes[VLString<>("user-agent")] = 1;
+    attributes[VLString<>("content-length")] = 2;
+    VLStringView header("content-length: 42", 14);
+    ASSERT_TRUE(attributes.Find(header) && *attributes.Find(header) == 2) // no VLString built for the lookup
+    ASSERT_TRUE(attributes.Contains("user-agent") && !attributes.Contains(VLStringView("host")))
+    attributes.Clear();
+    RETURN_ASSERT_TRUE(attributes.Empty() && !attributes.Contains("user-agent"))
+}
+
+int TestVLRingBuffer() {
+    VLRingBuffer<int, 4> ring;
+    ASSERT_TRUE(ring.PushBack(1) && ring.PushBack(2) && ring.PushFront(0) && ring.PushBack(3))
+    ASSERT_TRUE(ring.Full() && !ring.PushBack(4) && !ring.PushFront(-1) && ring.Size() == 4)
+    ASSERT_TRUE(ring[0] == 0 && ring[3] == 3 && ring.FirstSpan().Size() + ring.SecondSpan().Size() == 4)
+    ASSERT_THROWING(ring.At(4);)
+    ring.PopFront();
+    ring.PopFront();
+    ASSERT_TRUE(ring.PushBack(4) && ring.PushBack(5) && ring.Front() == 2 && ring.Back() == 5)
+    VLSpan<const int> first = ring.FirstSpan(), second = ring.SecondSpan();
+    ASSERT_TRUE(first.Size() == 3 && first[0] == 2 && second.Size() == 1 && second[0] == 5) // wrapped
+
+    // a FIFO that never shifts, checked against std::deque through the heap spill and back
+    VLDeque<int, STATIC_CAP> deque;
+    std::deque<int> reference;
+    for (int ix = 0 ; ix < 100 ; ix++){
+        if (ix % 3 == 0){
+            deque.PushFront(ix);
+            reference.push_front(ix);
+        } else {
+            deque.PushBack(ix);
+            reference.push_back(ix);
+        }
+    }
+    ASSERT_TRUE(deque.Size() == 100 && deque.Capacity() > STATIC_CAP)
+    VLDeque<int, STATIC_CAP> copy(deque);
+    for (size_t ix = 0 ; ix < reference.size() ; ix++){
+        ASSERT_TRUE(deque[ix] == reference[ix] && copy[ix] == reference[ix])
+    }
+    for (int ix = 0 ; ix < 60 ; ix++){
+        ASSERT_TRUE(deque.Front() == reference.front())
+        deque.PopFront();
+        reference.pop_front();
+        if (ix % 2 == 0){
+            deque.PopBack();
+            reference.pop_back();
+        }
+    }
+    ASSERT_CAPACITY(deque, STATIC_CAP)
+    int out[STATIC_CAP];
+    VLSpan<const int> head = deque.FirstSpan(), tail = deque.SecondSpan();
+    std::copy(tail.begin(), tail.end(), std::copy(head.begin(), head.end(), out));
+    ASSERT_TRUE(deque.Size() == reference.size() && std::equal(reference.begin(), reference.end(), out))
+
+    // hovering around StaticCapacity items stays in one heap buffer
+    VLDeque<int, STATIC_CAP> queue;
+    for (int ix = 0 ; ix <= STATIC_CAP ; ix++){
+        queue.PushBack(ix);
+    }
+    size_t heap_cap = queue.Capacity();
+    for (int ix = 0 ; ix < 10 ; ix++){
+        queue.PopFront();
+        queue.PushBack(ix);
+        ASSERT_CAPACITY(queue, heap_cap)
+    }
+    while (queue.Size() > STATIC_CAP / 2){
+        queue.PopBack();
+    }
+    ASSERT_CAPACITY(queue, STATIC_CAP)
+
+    // pushing an item of the deque itself while it grows
+    std::deque<int> expected;
+    for (size_t ix = 0 ; ix < queue.Size() ; ix++){
+        expected.push_back(queue[ix]);
+    }
+    while (queue.Size() < 40){
+        queue.PushBack(queue.Front());
+        expected.push_back(expected.front());
+        queue.PushFront(queue.Back());
+        expected.push_front(expected.back());
+    }
+    for (size_t ix = 0 ; ix < expected.size() ; ix++){
+        ASSERT_TRUE(queue[ix] == expected[ix])
+    }
+    return 1;
+}
+
+int TestVLBitVector() {
+    VLBitVector<128> bits(130);
+    ASSERT_TRUE(bits.Size() == 130 && bits.Count() == 0 && bits.FindFirst() == 130 && !bits.Any())
+    bits.Set(0);
+    bits.Set(63);
+    bits.Set(64);
+    bits.Set(129);
+    ASSERT_TRUE(bits.Count() == 4 && bits.Test(63) && !bits.Test(62) && bits.Words().Size() == 3)
+    ASSERT_TRUE(bits.FindFirst() == 0 && bits.FindNext(0) == 63 && bits.FindNext(63) == 64 && bits.FindNext(64) == 129)
+    ASSERT_TRUE(bits.FindNext(129) == 130)
+    ASSERT_THROWING(bits.At(130);)
+    bits.Reset(0);
+    bits.Flip(1);
+    ASSERT_TRUE(!bits[0] && bits[1] && bits.Count() == 4)
+
+    // the masks of a query filter, checked against std::vector<bool>
+    const size_t rows = 1000;
+    VLBitVector<> even(rows), threes(rows, true);
+    std::vector<bool> ref_even(rows), ref_threes(rows, true);
+    for (size_t ix = 0 ; ix < rows ; ix++){
+        even.Set(ix, ix % 2 == 0);
+        ref_even[ix] = ix % 2 == 0;
+        if (ix % 3 != 0){
+            threes.Reset(ix);
+            ref_threes[ix] = false;
+        }
+    }
+    ASSERT_TRUE(threes.Count() == 334)
+    VLBitVector<> both = even, either = even, only_even = even, one = even;
+    both &= threes;
+    either |= threes;
+    only_even.AndNot(threes);
+    one ^= threes;
+    size_t seen = 0;
+    for (size_t ix = both.FindFirst() ; ix < rows ; ix = both.FindNext(ix)){
+        ASSERT_TRUE(ix % 6 == 0)
+        seen++;
+    }
+    ASSERT_TRUE(seen == 167 && both.Count() == 167)
+    for (size_t ix = 0 ; ix < rows ; ix++){
+        ASSERT_TRUE(either[ix] == (ref_even[ix] || ref_threes[ix]) && only_even[ix] == (ref_even[ix] && !ref_threes[ix]))
+        ASSERT_TRUE(one[ix] == (ref_even[ix] != ref_threes[ix]))
+    }
+    VLBitVector<> shorter(rows - 1);
+    ASSERT_THROWING(shorter &= even;)
+
+    VLBitVector<64> grown;
+    for (int ix = 0 ; ix < 70 ; ix++){
+        grown.PushBack(ix % 7 == 0);
+    }
+    grown.Resize(200, true);
+    ASSERT_TRUE(grown.Count() == 10 + 130 && grown.FindNext(63) == 70)
+    grown.Resize(65);
+    grown.SetAll();
+    RETURN_ASSERT_TRUE(grown.Count() == 65 && grown == VLBitVector<64>(65, true))
+}
+
+int TestVLSoAVector() {
+    // (timestamp, price, quantity) trades
+    VLSoAVector<STATIC_CAP, long long, double, int> trades;
+    for (int ix = 0 ; ix < 40 ; ix++){
+        if (ix % 2 == 0){
+            trades.PushBack(1000LL + ix, 10.0 + ix, ix);
+        } else {
+            trades.PushBack(std::make_tuple(1000LL + ix, 10.0 + ix, ix));
+        }
+    }
+    ASSERT_TRUE(trades.Size() == 40 && trades.Capacity() > STATIC_CAP)
+
+    const auto &const_trades = trades;
+    VLSpan<const double> prices = const_trades.Column<1>();
+    double sum = 0;
+    for (double price : prices){
+        sum += price;
+    }
+    ASSERT_TRUE(prices.Size() == 40 && sum == 40 * 10.0 + 39 * 40 / 2)
+
+    VLSpan<int> quantities = trades.Column<2>();
+    for (size_t ix = 0 ; ix < quantities.Size() ; ix++){
+        quantities[ix] *= 2;
+    }
+    ASSERT_TRUE(trades.Get<2>(39) == 78 && trades.Get<0>(39) == 1039)
+    ASSERT_TRUE(trades.At(5) == std::make_tuple(1005LL, 15.0, 10))
+    trades.Set(5, std::make_tuple(1LL, 2.0, 3));
+    ASSERT_TRUE(trades.Get<1>(5) == 2.0)
+    ASSERT_THROWING(trades.At(40);)
+
+    while (trades.Size() > 4){
+        trades.PopBack();
+    }
+    ASSERT_TRUE(trades.Capacity() == STATIC_CAP && trades.Get<0>(3) == 1003 && trades.Column<0>().Size() == 4)
+    trades.Clear();
+    RETURN_ASSERT_TRUE(trades.Empty())
+}
+
+int TestVLPriorityQueue() {
+    // a timer queue: earliest deadline on top
+    VLPriorityQueue<int, 8, std::greater<int>> timers;
+    VLPriorityQueue<int, 8, std::greater<int>>::Handle handles[6];
+    int deadlines[] = {50, 20, 70, 10, 40, 60};
+    for (int ix = 0 ; ix < 6 ; ix++){
+        handles[ix] = timers.Push(deadlines[ix]);
+    }
+    ASSERT_TRUE(timers.Size() == 6 && timers.Top() == 10 && timers.TopHandle() == handles[3])
+    timers.DecreaseKey(handles[2], 5); // 70 -> 5 moves up
+    ASSERT_TRUE(timers.Top() == 5 && timers.Get(handles[2]) == 5)
+    timers.DecreaseKey(handles[2], 100); // and back down
+    ASSERT_TRUE(timers.Top() == 10 && timers.Get(handles[2]) == 100)
+    timers.Pop();
+    ASSERT_TRUE(!timers.Contains(handles[3]) && timers.Top() == 20)
+    ASSERT_THROWING(timers.DecreaseKey(handles[3], 1);)
+
+    // random pushes, pops and key changes against std::priority_queue on the final drain
+    VLPriorityQueue<int, STATIC_CAP, std::less<int>, 8> heap;
+    std::vector<VLPriorityQueue<int, STATIC_CAP, std::less<int>, 8>::Handle> live;
+    unsigned seed = 7;
+    for (int step = 0 ; step < 3000 ; step++){
+        seed = seed * 1103515245 + 12345;
+        int value = (int) ((seed >> 8) % 10000);
+        if (step % 5 == 4 && !live.empty()){
+            size_t pick = (seed >> 4) % live.size();
+            if (heap.Contains(live[pick])){
+                heap.DecreaseKey(live[pick], value);
+            }
+        } else if (step % 7 == 6){
+            heap.Pop();
+        } else {
+            live.push_back(heap.Push(value));
+        }
+    }
+    std::vector<int> remaining;
+    VLPriorityQueue<int, STATIC_CAP, std::less<int>, 8> copy = heap;
+    while (!copy.Empty()){
+        remaining.push_back(copy.Top());
+        copy.Pop();
+    }
+    ASSERT_TRUE(remaining.size() == heap.Size() && std::is_sorted(remaining.rbegin(), remaining.rend()))
+
+    std::priority_queue<int> reference(remaining.begin(), remaining.end());
+    VLPriorityQueue<int> bulk;
+    bulk.Heapify(remaining.rbegin(), remaining.rend());
+    ASSERT_TRUE(bulk.Get(0) == remaining.back())
+    while (!reference.empty()){
+        ASSERT_TRUE(bulk.Top() == reference.top())
+        bulk.Pop();
+        reference.pop();
+    }
+    RETURN_ASSERT_TRUE(bulk.Empty())
+}
+
+int TestVLStableVector() {
+    VLStableVector<int, 4, 8> stable;
+    int &first = stable.PushBack(0);
+    int *inline_item = &first;
+    int *heap_item = nullptr;
+    for (int ix = 1 ; ix < 100 ; ix++){
+        int &item = stable.PushBack(ix);
+        if (ix == 10){
+            heap_item = &item;
+        }
+    }
+    ASSERT_TRUE(stable.Size() == 100 && stable.Capacity() == 4 + 12 * 8)
+    ASSERT_TRUE(inline_item == &stable[0] && heap_item == &stable[10] && *heap_item == 10) // nothing moved
+    ASSERT_TRUE(stable[99] == 99 && stable.Back() == 99 && stable.SegmentCount() == 1 + 12)
+    ASSERT_THROWING(stable.At(100);)
+
+    long long sum = 0;
+    size_t runs = 0;
+    stable.ForEachSegment([&sum, &runs](VLSpan<int> run) {
+        for (int value : run){
+            sum += value;
+        }
+        runs++;
+    });
+    ASSERT_TRUE(sum == 99 * 100 / 2 && runs == 13 && stable.Segment(12).Size() == 8)
+
+    for (int ix = 0 ; ix < 50 ; ix++){
+        stable.PopBack();
+    }
+    ASSERT_TRUE(stable.Capacity() == 4 + 12 * 8) // the segments stay for the next pushes
+    stable.ShrinkToFit();
+    ASSERT_TRUE(stable.Capacity() == 4 + 6 * 8 && stable[49] == 49)
+
+    VLStableVector<int, 4, 8> copy(stable);
+    copy[0] = -1;
+    ASSERT_TRUE(copy.Size() == 50 && copy[49] == 49 && stable[0] == 0)
+    stable.Clear();
+    RETURN_ASSERT_TRUE(stable.Empty() && stable.Capacity() == 4 && stable.SegmentCount() == 0)
+}
+
+int TestVLSlotMap() {
+    VLSlotMap<VLString<>> sessions;
+    VLSlotMap<VLString<>>::Handle alice = sessions.Insert(VLString<>("alice"));
+    VLSlotMap<VLString<>>::Handle bob = sessions.Insert(VLString<>("bob"));
+    VLSlotMap<VLString<>>::Handle carol = sessions.Insert(VLString<>("carol"));
+    ASSERT_TRUE(sessions.Size() == 3 && *sessions.Get(bob) == "bob" && !sessions.Contains(SLOT_NULL_HANDLE))
+
+    ASSERT_TRUE(sessions.Erase(alice) && !sessions.Erase(alice) && sessions.Get(alice) == nullptr)
+    ASSERT_TRUE(sessions.Values()[0] == "carol" && sessions.HandleAt(0) == carol) // the last value filled the hole
+    VLSlotMap<VLString<>>::Handle dave = sessions.Insert(VLString<>("dave"));
+    ASSERT_TRUE((uint32_t) dave == (uint32_t) alice && dave != alice) // same slot, new generation
+    ASSERT_TRUE(sessions.Get(alice) == nullptr && *sessions.Get(dave) == "dave" && *sessions.Get(carol) == "carol")
+
+    // churn against std::map, every live handle must keep finding its own value
+    VLSlotMap<int, 8> pool;
+    std::map<VLSlotMap<int, 8>::Handle, int> reference;
+    std::vector<VLSlotMap<int, 8>::Handle> erased;
+    unsigned seed = 99;
+    for (int step = 0 ; step < 5000 ; step++){
+        seed = seed * 1103515245 + 12345;
+        if ((seed >> 8) % 3 == 0 && !reference.empty()){
+            auto victim = reference.begin();
+            std::advance(victim, (seed >> 4) % reference.size());
+            ASSERT_TRUE(pool.Erase(victim->first))
+            erased.push_back(victim->first);
+            reference.erase(victim);
+        } else {
+            reference[pool.Insert(step)] = step;
+        }
+    }
+    ASSERT_TRUE(pool.Size() == reference.size())
+    for (const auto &entry : reference){
+        ASSERT_TRUE(pool.Get(entry.first) && *pool.Get(entry.first) == entry.second)
+    }
+    for (auto handle : erased){
+        ASSERT_TRUE(!pool.Contains(handle))
+    }
+    long long sum = 0, reference_sum = 0;
+    for (int value : pool.Values()){
+        sum += value;
+    }
+    for (const auto &entry : reference){
+        reference_sum += entry.second;
+    }
+    ASSERT_TRUE(sum == reference_sum)
+    pool.Clear();
+    RETURN_ASSERT_TRUE(pool.Empty() && !pool.Contains(reference.begin()->first))
+}
+
+int TestVLJaggedVector() {
+    VLJaggedVector<uint32_t> graph;
+    uint32_t first_row[] = {1, 2, 3};
+    graph.AppendRow(first_row, first_row + 3);
+    graph.AppendRow(first_row, first_row); // a node with no edges
+    VLVector<uint32_t, 4> edges;
+    edges.PushBack(0);
+    edges.PushBack(3);
+    graph.AppendRow(VLSpan<const uint32_t>(edges));
+    ASSERT_TRUE(graph.RowCount() == 3 && graph.Size() == 5 && graph.Row(1).Empty() && graph.Row(2)[1] == 3)
+    ASSERT_THROWING(graph.Row(3);)
+
+    graph.EraseFromRow(0, 0);
+    ASSERT_TRUE(graph.Row(0).Size() == 2 && graph.Row(0)[0] == 2 && graph.Slack() == 1 && graph.Row(2)[0] == 0)
+    graph.Compact();
+    ASSERT_TRUE(graph.Slack() == 0 && graph.Size() == 4 && graph.Row(2)[0] == 0 && graph.Row(2)[1] == 3)
+
+    // bulk build from an edge list, checked against per row std::vectors
+    std::vector<std::pair<size_t, uint32_t>> pairs;
+    std::vector<std::vector<uint32_t>> reference(50);
+    for (uint32_t ix = 0 ; ix < 400 ; ix++){
+        size_t row = (ix * 37) % 50;
+        if (row % 7 == 3) {continue;} // leave some rows empty
+        pairs.push_back(std::make_pair(row, ix));
+        reference[row].push_back(ix);
+    }
+    VLJaggedVector<uint32_t> built;
+    built.Build(pairs.begin(), pairs.end(), 50);
+    ASSERT_TRUE(built.RowCount() == 50 && built.Size() == pairs.size())
+    for (size_t row = 0 ; row < 50 ; row++){
+        VLSpan<uint32_t> values = built.Row(row);
+        ASSERT_TRUE(values.Size() == reference[row].size() && std::equal(values.begin(), values.end(), reference[row].begin()))
+    }
+
+    // rows copied from the vector itself, through several growths of the values
+    const VLJaggedVector<uint32_t> &const_built = built;
+    for (size_t row = 0 ; row < 200 ; row++){
+        built.AppendRow(const_built.Row(row % 50));
+        VLSpan<uint32_t> values = built.Row(built.RowCount() - 1);
+        ASSERT_TRUE(std::equal(values.begin(), values.end(), reference[row % 50].begin()))
+    }
+    for (size_t row = 0 ; row < 200 ; row++){ // the same through an iterator range
+        VLSpan<uint32_t> source = built.Row(row % 50);
+        built.AppendRow(source.begin(), source.end());
+        VLSpan<uint32_t> values = built.Row(built.RowCount() - 1);
+        ASSERT_TRUE(std::equal(values.begin(), values.end(), reference[row % 50].begin()))
+    }
+    pairs.push_back(std::make_pair((size_t) 50, 0u));
+    ASSERT_THROWING(built.Build(pairs.begin(), pairs.end(), 50);)
+    RETURN_ASSERT_TRUE(built.Empty() && built.Size() == 0)
+}
+
+int TestVLSparseSet() {
+    VLSparseSet<> active;
+    ASSERT_TRUE(active.Insert(5) && active.Insert(1) && active.Insert(300) && !active.Insert(5))
+    ASSERT_TRUE(active.Size() == 3 && active.Contains(300) && !active.Contains(2) && !active.Contains(100000))
+    ASSERT_TRUE(active.Members()[0] == 5 && active.Members()[1] == 1 && active.Members()[2] == 300) // insertion order
+    ASSERT_TRUE(active.Erase(5) && !active.Erase(5) && active.Members()[0] == 300 && active.Contains(1))
+
+    active.Clear();
+    ASSERT_TRUE(active.Empty() && !active.Contains(1) && !active.Contains(300))
+    ASSERT_TRUE(active.Insert(300) && active.Size() == 1 && !active.Contains(1)) // stale entries stay out
+
+    // per frame active sets, checked against std::set
+    VLSparseSet<8> frame;
+    unsigned seed = 5;
+    for (int round = 0 ; round < 20 ; round++){
+        frame.Clear();
+        std::set<uint32_t> reference;
+        for (int step = 0 ; step < 200 ; step++){
+            seed = seed * 1103515245 + 12345;
+            uint32_t id = (seed >> 8) % 500;
+            if ((seed >> 4) % 4 == 0){
+                ASSERT_TRUE(frame.Erase(id) == (reference.erase(id) == 1))
+            } else {
+                ASSERT_TRUE(frame.Insert(id) == reference.insert(id).second)
+            }
+        }
+        ASSERT_TRUE(frame.Size() == reference.size())
+        std::set<uint32_t> members(frame.begin(), frame.end());
+        ASSERT_TRUE(members == reference)
+    }
+    RETURN_ASSERT_TRUE(!frame.Empty())
+}
+
 //#endif
 
 //-------------------------------------------------------
@@ -270,6 +1277,31 @@ int RunPresubmitChecks() {
 //#ifdef BONUS_IMPLEMENTED
     PRESUBMISSION_ASSERT(TestVLStringCreateString)
   PRESUBMISSION_ASSERT(TestVLStringConcat)
+    PRESUBMISSION_ASSERT(TestVLStringHash)
+    PRESUBMISSION_ASSERT(TestVLStringInterner)
+    PRESUBMISSION_ASSERT(TestVLStringNumbers)
+    PRESUBMISSION_ASSERT(TestVLStringFormat)
+    PRESUBMISSION_ASSERT(TestVLStringAscii)
+    PRESUBMISSION_ASSERT(TestVLStringUtf8)
+    PRESUBMISSION_ASSERT(TestVLStringCompare)
+    PRESUBMISSION_ASSERT(TestVLCowString)
+    PRESUBMISSION_ASSERT(TestVLRope)
+    PRESUBMISSION_ASSERT(TestVLStringEdit)
+    PRESUBMISSION_ASSERT(TestVLBasicString)
+    PRESUBMISSION_ASSERT(TestVLStringEscape)
+    PRESUBMISSION_ASSERT(TestVLStringCodec)
+    PRESUBMISSION_ASSERT(TestVLFixedString)
+    PRESUBMISSION_ASSERT(TestVLStringBuf)
+    PRESUBMISSION_ASSERT(TestVLFlatMap)
+    PRESUBMISSION_ASSERT(TestVLHashMap)
+    PRESUBMISSION_ASSERT(TestVLRingBuffer)
+    PRESUBMISSION_ASSERT(TestVLBitVector)
+    PRESUBMISSION_ASSERT(TestVLSoAVector)
+    PRESUBMISSION_ASSERT(TestVLPriorityQueue)
+    PRESUBMISSION_ASSERT(TestVLStableVector)
+    PRESUBMISSION_ASSERT(TestVLSlotMap)
+    PRESUBMISSION_ASSERT(TestVLJaggedVector)
+    PRESUBMISSION_ASSERT(TestVLSparseSet)
 //#endif
 
     return 1;
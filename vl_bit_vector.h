@@ -0,0 +1,266 @@
+#ifndef VL_BIT_VECTOR_H_
+#define VL_BIT_VECTOR_H_
+
+#ifndef START_CAP
+#include "vl_vector.h"
+#endif
+#include "vl_swar.h"
+#include <stdexcept>
+
+#define BITS_MISMATCH "bit vectors differ in size.\n"
+
+
+/**
+ * packed bools, 64 per uint64_t word, on VLVector storage.
+ * the first StaticBits bits live inline. Count, FindFirst / FindNext and the
+ * And / Or / Xor / AndNot ops work on whole words; the bitwise loops have no branches,
+ * so the compiler can vectorize them.
+ * the bits past Size() in the last word are always zero.
+ * @tparam StaticBits bits kept inline, rounded up to a whole word
+ */
+template<size_t StaticBits = START_CAP * 64>
+class VLBitVector{
+
+    static const size_t STATIC_WORDS = (StaticBits + 63) / 64;
+
+    VLVector<uint64_t, STATIC_WORDS> words_;
+    size_t size_;
+
+    static size_t WordsFor(const size_t bits) noexcept{
+        return (bits + 63) / 64;
+    }
+
+    /**
+     * zeroes the bits of the last word that are past size_.
+     */
+    void ClearTail() noexcept{
+        if (size_ % 64 != 0){
+            words_[words_.Size() - 1] &= (1ULL << (size_ % 64)) - 1;
+        }
+    }
+
+    void CheckSize(const VLBitVector &rhs) const{
+        if (rhs.size_ != size_){
+            throw std::invalid_argument (BITS_MISMATCH);
+        }
+    }
+
+    public:
+
+    VLBitVector(): size_(0) {}
+
+    /**
+     * @param size number of bits
+     * @param value of every bit
+     */
+    explicit VLBitVector(const size_t size, const bool value = false): size_(0) {
+        Resize(size, value);
+    }
+
+    /**
+     * @return number of bits
+     */
+    size_t Size() const noexcept{
+        return size_;
+    }
+
+    bool Empty() const noexcept{
+        return size_ == 0;
+    }
+
+    /**
+     * grows with value bits or drops the bits past size.
+     * @param size
+     * @param value
+     */
+    void Resize(const size_t size, const bool value = false){
+        if (size > size_){
+            size_t old_size = size_;
+            size_t old_words = words_.Size();
+            uint64_t *added = words_.Grow(WordsFor(size) - old_words);
+            memset(added, value ? 0xff : 0, (WordsFor(size) - old_words) * sizeof(uint64_t));
+            if (value && old_size % 64 != 0){ // the tail of the old last word
+                words_[old_words - 1] |= ~0ULL << (old_size % 64);
+            }
+        } else {
+            while (words_.Size() > WordsFor(size)){
+                words_.PopBack();
+            }
+        }
+        size_ = size;
+        ClearTail();
+    }
+
+    void PushBack(const bool value){
+        if (size_ % 64 == 0){
+            words_.PushBack(0);
+        }
+        size_++;
+        Set(size_ - 1, value);
+    }
+
+    bool Test(const size_t index) const noexcept{
+        return (words_.Data()[index / 64] >> (index % 64)) & 1;
+    }
+
+    bool operator[](const size_t index) const noexcept{
+        return Test(index);
+    }
+
+    bool At(const size_t index) const{
+        if (index >= size_){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        return Test(index);
+    }
+
+    void Set(const size_t index) noexcept{
+        words_.Data()[index / 64] |= 1ULL << (index % 64);
+    }
+
+    void Set(const size_t index, const bool value) noexcept{
+        uint64_t &word = words_.Data()[index / 64];
+        uint64_t bit = 1ULL << (index % 64);
+        word = (word & ~bit) | (value ? bit : 0);
+    }
+
+    void Reset(const size_t index) noexcept{
+        words_.Data()[index / 64] &= ~(1ULL << (index % 64));
+    }
+
+    void Flip(const size_t index) noexcept{
+        words_.Data()[index / 64] ^= 1ULL << (index % 64);
+    }
+
+    void SetAll() noexcept{
+        memset(words_.Data(), 0xff, words_.Size() * sizeof(uint64_t));
+        ClearTail();
+    }
+
+    void ResetAll() noexcept{
+        memset(words_.Data(), 0, words_.Size() * sizeof(uint64_t));
+    }
+
+    /**
+     * @return number of set bits
+     */
+    size_t Count() const noexcept{
+        size_t ret = 0;
+        const uint64_t *words = words_.Data();
+        for (size_t ix = 0 ; ix < words_.Size() ; ix++){
+            ret += VLPopCount64(words[ix]);
+        }
+        return ret;
+    }
+
+    bool Any() const noexcept{
+        return FindFirst() != size_;
+    }
+
+    /**
+     * @return index of the first set bit, Size() if there is none
+     */
+    size_t FindFirst() const noexcept{
+        const uint64_t *words = words_.Data();
+        for (size_t ix = 0 ; ix < words_.Size() ; ix++){
+            if (words[ix] != 0){
+                return ix * 64 + VLCountTrailingZeros64(words[ix]);
+            }
+        }
+        return size_;
+    }
+
+    /**
+     * @param index
+     * @return index of the first set bit after index, Size() if there is none
+     */
+    size_t FindNext(const size_t index) const noexcept{
+        size_t next = index + 1;
+        if (next >= size_) {return size_;}
+        const uint64_t *words = words_.Data();
+        size_t ix = next / 64;
+        uint64_t word = words[ix] & (~0ULL << (next % 64));
+        while (word == 0){
+            if (++ix == words_.Size()) {return size_;}
+            word = words[ix];
+        }
+        return ix * 64 + VLCountTrailingZeros64(word);
+    }
+
+    /**
+     * this &= rhs, word by word.
+     * throws std::invalid_argument if the sizes differ.
+     */
+    VLBitVector &And(const VLBitVector &rhs){
+        CheckSize(rhs);
+        uint64_t *words = words_.Data();
+        const uint64_t *other = rhs.words_.Data();
+        for (size_t ix = 0 ; ix < words_.Size() ; ix++){
+            words[ix] &= other[ix];
+        }
+        return *this;
+    }
+
+    VLBitVector &Or(const VLBitVector &rhs){
+        CheckSize(rhs);
+        uint64_t *words = words_.Data();
+        const uint64_t *other = rhs.words_.Data();
+        for (size_t ix = 0 ; ix < words_.Size() ; ix++){
+            words[ix] |= other[ix];
+        }
+        return *this;
+    }
+
+    VLBitVector &Xor(const VLBitVector &rhs){
+        CheckSize(rhs);
+        uint64_t *words = words_.Data();
+        const uint64_t *other = rhs.words_.Data();
+        for (size_t ix = 0 ; ix < words_.Size() ; ix++){
+            words[ix] ^= other[ix];
+        }
+        return *this;
+    }
+
+    /**
+     * this &= ~rhs, clears every bit set in rhs.
+     */
+    VLBitVector &AndNot(const VLBitVector &rhs){
+        CheckSize(rhs);
+        uint64_t *words = words_.Data();
+        const uint64_t *other = rhs.words_.Data();
+        for (size_t ix = 0 ; ix < words_.Size() ; ix++){
+            words[ix] &= ~other[ix];
+        }
+        return *this;
+    }
+
+    VLBitVector &operator&=(const VLBitVector &rhs){
+        return And(rhs);
+    }
+
+    VLBitVector &operator|=(const VLBitVector &rhs){
+        return Or(rhs);
+    }
+
+    VLBitVector &operator^=(const VLBitVector &rhs){
+        return Xor(rhs);
+    }
+
+    bool operator==(const VLBitVector &rhs) const noexcept{
+        return size_ == rhs.size_
+               && memcmp(words_.Data(), rhs.words_.Data(), words_.Size() * sizeof(uint64_t)) == 0;
+    }
+
+    bool operator!=(const VLBitVector &rhs) const noexcept{
+        return !(*this == rhs);
+    }
+
+    /**
+     * the raw words, bit i is bit i % 64 of word i / 64.
+     */
+    const VLVector<uint64_t, STATIC_WORDS>& Words() const noexcept{
+        return words_;
+    }
+};
+
+#endif // VL_BIT_VECTOR_H_
@@ -0,0 +1,168 @@
+#ifndef VL_FIXED_STRING_H_
+#define VL_FIXED_STRING_H_
+
+#include "vl_string.h"
+
+#define FIXED_TOO_LONG "string too long for VLFixedString.\n"
+
+
+/**
+ * a string of at most MaxChars chars that lives entirely inside the object.
+ * no heap, no pointers, no virtual calls: it is trivially copyable, so VLVector and
+ * anything else that moves memory around can copy it with memcpy.
+ * the storage is rounded up to whole 64 bit words. the last byte holds the number of
+ * unused chars and every unused byte is zero, so equality and hashing work on whole words,
+ * and a full string still ends with a \0 (its spare count is 0).
+ * @tparam MaxChars at most 255
+ */
+template<size_t MaxChars>
+class VLFixedString{
+
+    static_assert(MaxChars >= 1 && MaxChars <= 255, "VLFixedString holds 1 to 255 chars");
+
+    public:
+    static const size_t WORDS = (MaxChars + 1 + 7) / 8;
+    static const size_t CAPACITY = WORDS * 8 - 1; // MaxChars rounded up to fill the last word
+
+    private:
+    alignas(uint64_t) char bytes_[WORDS * 8];
+
+    void SetSize(const size_t size) noexcept{
+        bytes_[CAPACITY] = (char) (CAPACITY - size);
+    }
+
+    public:
+
+    VLFixedString() noexcept{
+        memset(bytes_, 0, sizeof(bytes_));
+        SetSize(0);
+    }
+
+    explicit VLFixedString(const VLStringView str){
+        memset(bytes_, 0, sizeof(bytes_));
+        SetSize(0);
+        Append(str);
+    }
+
+    explicit VLFixedString(const char *str): VLFixedString(VLStringView(str)) {}
+
+    /**
+     * @return number of chars
+     */
+    size_t Size() const noexcept{
+        return CAPACITY - (unsigned char) bytes_[CAPACITY];
+    }
+
+    bool Empty() const noexcept{
+        return Size() == 0;
+    }
+
+    /**
+     * @return the chars, always followed by \0
+     */
+    const char* Data() const noexcept{
+        return bytes_;
+    }
+
+    const char* CStr() const noexcept{
+        return bytes_;
+    }
+
+    char operator[](const size_t index) const noexcept{
+        return bytes_[index];
+    }
+
+    char At(const size_t index) const{
+        if (index >= Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        return bytes_[index];
+    }
+
+    VLStringView View() const noexcept{
+        return VLStringView(bytes_, Size());
+    }
+
+    operator VLStringView() const noexcept{
+        return View();
+    }
+
+    /**
+     * @param str
+     * throws std::length_error if the result would not fit, the string is unchanged then
+     */
+    void Append(const VLStringView str){
+        size_t size = Size();
+        if (str.Size() > MaxChars - size){
+            throw std::length_error (FIXED_TOO_LONG);
+        }
+        memcpy(bytes_ + size, str.Data(), str.Size());
+        SetSize(size + str.Size());
+    }
+
+    void PushBack(const char c){
+        Append(VLStringView(&c, 1));
+    }
+
+    void PopBack() noexcept{
+        size_t size = Size();
+        if (size == 0) {return;}
+        bytes_[size - 1] = '\0';
+        SetSize(size - 1);
+    }
+
+    void Clear() noexcept{
+        memset(bytes_, 0, sizeof(bytes_));
+        SetSize(0);
+    }
+
+    /**
+     * compares word by word, the size byte is part of the last word.
+     */
+    bool operator==(const VLFixedString &rhs) const noexcept{
+        uint64_t diff = 0;
+        for (size_t ix = 0 ; ix < WORDS ; ix++){
+            diff |= SwarLoad(bytes_ + ix * 8) ^ SwarLoad(rhs.bytes_ + ix * 8);
+        }
+        return diff == 0;
+    }
+
+    bool operator!=(const VLFixedString &rhs) const noexcept{
+        return !(*this == rhs);
+    }
+
+    bool operator<(const VLFixedString &rhs) const noexcept{
+        return View().Compare(rhs.View()) < 0;
+    }
+
+    int Compare(const VLStringView rhs) const noexcept{
+        return View().Compare(rhs);
+    }
+
+    /**
+     * hashes the whole fixed size storage, so the length is known at compile time.
+     * note it differs from the VLString hash of the same chars.
+     * @return 64 bit hash
+     */
+    uint64_t Hash() const noexcept{
+        return VLHashBytes(bytes_, sizeof(bytes_));
+    }
+};
+
+/**
+ * the unused bytes are always zero, so equal strings have equal bytes.
+ */
+template<size_t MaxChars>
+struct VLIsTriviallyHashable<VLFixedString<MaxChars>> : std::true_type {};
+
+namespace std {
+
+    template<size_t MaxChars>
+    struct hash<VLFixedString<MaxChars>> {
+        size_t operator()(const VLFixedString<MaxChars> &str) const noexcept {
+            return str.Hash();
+        }
+    };
+}
+
+#endif // VL_FIXED_STRING_H_
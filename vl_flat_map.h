@@ -0,0 +1,365 @@
+#ifndef VL_FLAT_MAP_H_
+#define VL_FLAT_MAP_H_
+
+#ifndef START_CAP
+#include "vl_vector.h"
+#endif
+#include <utility>
+
+#define FLAT_LINEAR_LIMIT 16
+
+
+/**
+ * index of the first item of the sorted data that is not less than key.
+ * up to FLAT_LINEAR_LIMIT items are scanned in order, which beats any search on a few cache lines.
+ * larger arrays use a branchless binary search: the loop only halves n, and the compiler
+ * turns the choice of base into a conditional move, so there are no mispredicted branches.
+ * @return index in [0, size]
+ */
+template<class K, class Compare>
+size_t VLFlatLowerBound(const K *data, const size_t size, const K &key, const Compare &less){
+    if (size <= FLAT_LINEAR_LIMIT){
+        size_t ix = 0;
+        while (ix < size && less(data[ix], key)){
+            ix++;
+        }
+        return ix;
+    }
+    const K *base = data;
+    size_t n = size;
+    while (n > 1){
+        size_t half = n / 2;
+        base = less(base[half], key) ? base + half : base;
+        n -= half;
+    }
+    return (base - data) + less(*base, key);
+}
+
+
+/**
+ * a map kept as two sorted arrays, keys and values, on VLVector storage.
+ * the first StaticCapacity entries live inline, so small maps never allocate,
+ * and lookups only walk the keys array.
+ * inserting and erasing shift the entries after the position, InsertRange adds many at once.
+ * @tparam K
+ * @tparam V
+ * @tparam StaticCapacity
+ * @tparam Compare
+ */
+template<class K, class V, size_t StaticCapacity = START_CAP, class Compare = std::less<K>>
+class VLFlatMap{
+
+    VLVector<K, StaticCapacity> keys_;
+    VLVector<V, StaticCapacity> values_;
+    Compare less_;
+
+    size_t LowerBound(const K &key) const{
+        return VLFlatLowerBound(keys_.Data(), keys_.Size(), key, less_);
+    }
+
+    bool FoundAt(const size_t ix, const K &key) const{
+        return ix < keys_.Size() && !less_(key, keys_.Data()[ix]);
+    }
+
+    /**
+     * makes room at ix and fills it.
+     * key and value are taken by copy, they may refer into the map and the growth moves it.
+     */
+    void InsertAt(const size_t ix, K key, V value){
+        keys_.Grow(1);
+        values_.Grow(1);
+        K *keys = keys_.Data();
+        V *values = values_.Data();
+        std::move_backward(keys + ix, keys + keys_.Size() - 1, keys + keys_.Size());
+        std::move_backward(values + ix, values + values_.Size() - 1, values + values_.Size());
+        keys[ix] = std::move(key);
+        values[ix] = std::move(value);
+    }
+
+    public:
+
+    VLFlatMap(): less_() {}
+
+    explicit VLFlatMap(const Compare &less): less_(less) {}
+
+    size_t Size() const noexcept{
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept{
+        return keys_.Empty();
+    }
+
+    /**
+     * @return pointer to the value of key, nullptr if it is missing. valid until the next change.
+     */
+    const V* Find(const K &key) const{
+        size_t ix = LowerBound(key);
+        return FoundAt(ix, key) ? values_.Data() + ix : nullptr;
+    }
+
+    V* Find(const K &key){
+        size_t ix = LowerBound(key);
+        return FoundAt(ix, key) ? values_.Data() + ix : nullptr;
+    }
+
+    bool Contains(const K &key) const{
+        return FoundAt(LowerBound(key), key);
+    }
+
+    /**
+     * @return the value of key, inserting a default one first if it is missing
+     */
+    V& operator[](const K &key){
+        size_t ix = LowerBound(key);
+        if (!FoundAt(ix, key)){
+            InsertAt(ix, key, V());
+        }
+        return values_.Data()[ix];
+    }
+
+    /**
+     * @return false if key was already there, its value is kept then
+     */
+    bool Insert(const K &key, const V &value){
+        size_t ix = LowerBound(key);
+        if (FoundAt(ix, key)){
+            return false;
+        }
+        InsertAt(ix, key, value);
+        return true;
+    }
+
+    /**
+     * @return true if key is new, false if its value was replaced
+     */
+    bool InsertOrAssign(const K &key, const V &value){
+        size_t ix = LowerBound(key);
+        if (FoundAt(ix, key)){
+            values_.Data()[ix] = value;
+            return false;
+        }
+        InsertAt(ix, key, value);
+        return true;
+    }
+
+    /**
+     * inserts every (key, value) pair of the range with one sort and one merge, O((n + m) + m log m).
+     * like Insert, keys already in the map, and later duplicates inside the range, are skipped.
+     * @tparam InputIterator iterates over std::pair<K, V> (or anything with first / second)
+     * @param first
+     * @param last
+     */
+    template<class InputIterator>
+    void InsertRange(InputIterator first, InputIterator last){
+        VLVector<std::pair<K, V>, StaticCapacity> added;
+        for (; first != last ; ++first){
+            added.PushBack(std::pair<K, V>(first->first, first->second));
+        }
+        const Compare &less = less_;
+        std::pair<K, V> *begin = added.Data();
+        std::pair<K, V> *end = begin + added.Size();
+        std::stable_sort(begin, end, [&less](const std::pair<K, V> &lhs, const std::pair<K, V> &rhs) {
+            return less(lhs.first, rhs.first);
+        });
+        end = std::unique(begin, end, [&less](const std::pair<K, V> &lhs, const std::pair<K, V> &rhs) {
+            return !less(lhs.first, rhs.first) && !less(rhs.first, lhs.first);
+        });
+
+        // count the new keys so the arrays grow once
+        size_t old_size = keys_.Size();
+        size_t fresh = 0;
+        const K *keys = keys_.Data();
+        for (size_t ix = 0, jx = 0 ; jx < (size_t) (end - begin) ; jx++){
+            while (ix < old_size && less_(keys[ix], begin[jx].first)){
+                ix++;
+            }
+            fresh += ix == old_size || less_(begin[jx].first, keys[ix]);
+        }
+        if (fresh == 0) {return;}
+        keys_.Grow(fresh);
+        values_.Grow(fresh);
+
+        // merge from the back, every entry moves at most once
+        K *out_keys = keys_.Data();
+        V *out_values = values_.Data();
+        size_t out = old_size + fresh;
+        size_t ix = old_size;
+        const std::pair<K, V> *it = end;
+        while (it != begin){
+            const std::pair<K, V> &pair = *(it - 1);
+            if (ix > 0 && !less_(out_keys[ix - 1], pair.first)){
+                bool same = !less_(pair.first, out_keys[ix - 1]);
+                out--;
+                ix--;
+                out_keys[out] = std::move(out_keys[ix]);
+                out_values[out] = std::move(out_values[ix]);
+                if (same){
+                    --it; // the key is already in the map
+                }
+            } else {
+                out--;
+                out_keys[out] = pair.first;
+                out_values[out] = pair.second;
+                --it;
+            }
+        }
+    }
+
+    /**
+     * @return false if key was not there
+     */
+    bool Erase(const K &key){
+        size_t ix = LowerBound(key);
+        if (!FoundAt(ix, key)){
+            return false;
+        }
+        K *keys = keys_.Data();
+        V *values = values_.Data();
+        std::move(keys + ix + 1, keys + keys_.Size(), keys + ix);
+        std::move(values + ix + 1, values + values_.Size(), values + ix);
+        keys_.PopBack();
+        values_.PopBack();
+        return true;
+    }
+
+    void Clear() noexcept{
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    /**
+     * the sorted keys, values are at the same indexes.
+     */
+    const VLVector<K, StaticCapacity>& Keys() const noexcept{
+        return keys_;
+    }
+
+    const VLVector<V, StaticCapacity>& Values() const noexcept{
+        return values_;
+    }
+
+    const K& KeyAt(const size_t index) const noexcept{
+        return keys_.Data()[index];
+    }
+
+    V& ValueAt(const size_t index) noexcept{
+        return values_.Data()[index];
+    }
+
+    const V& ValueAt(const size_t index) const noexcept{
+        return values_.Data()[index];
+    }
+};
+
+
+/**
+ * a set kept as one sorted VLVector, see VLFlatMap.
+ * @tparam K
+ * @tparam StaticCapacity
+ * @tparam Compare
+ */
+template<class K, size_t StaticCapacity = START_CAP, class Compare = std::less<K>>
+class VLFlatSet{
+
+    VLVector<K, StaticCapacity> keys_;
+    Compare less_;
+
+    size_t LowerBound(const K &key) const{
+        return VLFlatLowerBound(keys_.Data(), keys_.Size(), key, less_);
+    }
+
+    bool FoundAt(const size_t ix, const K &key) const{
+        return ix < keys_.Size() && !less_(key, keys_.Data()[ix]);
+    }
+
+    public:
+
+    VLFlatSet(): less_() {}
+
+    explicit VLFlatSet(const Compare &less): less_(less) {}
+
+    size_t Size() const noexcept{
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept{
+        return keys_.Empty();
+    }
+
+    bool Contains(const K &key) const{
+        return FoundAt(LowerBound(key), key);
+    }
+
+    /**
+     * @return false if key was already there
+     */
+    bool Insert(const K &key){
+        size_t ix = LowerBound(key);
+        if (FoundAt(ix, key)){
+            return false;
+        }
+        keys_.Grow(1);
+        K *keys = keys_.Data();
+        std::move_backward(keys + ix, keys + keys_.Size() - 1, keys + keys_.Size());
+        keys[ix] = key;
+        return true;
+    }
+
+    /**
+     * inserts every key of the range: appends them, sorts the new tail, merges it in place once
+     * and drops the duplicates.
+     * @tparam InputIterator
+     * @param first
+     * @param last
+     */
+    template<class InputIterator>
+    void InsertRange(InputIterator first, InputIterator last){
+        size_t old_size = keys_.Size();
+        for (; first != last ; ++first){
+            keys_.PushBack(*first);
+        }
+        K *begin = keys_.Data();
+        K *end = begin + keys_.Size();
+        const Compare &less = less_;
+        std::sort(begin + old_size, end, less);
+        std::inplace_merge(begin, begin + old_size, end, less);
+        K *new_end = std::unique(begin, end, [&less](const K &lhs, const K &rhs) {
+            return !less(lhs, rhs) && !less(rhs, lhs);
+        });
+        for (size_t drop = end - new_end ; drop > 0 ; drop--){
+            keys_.PopBack();
+        }
+    }
+
+    /**
+     * @return false if key was not there
+     */
+    bool Erase(const K &key){
+        size_t ix = LowerBound(key);
+        if (!FoundAt(ix, key)){
+            return false;
+        }
+        K *keys = keys_.Data();
+        std::move(keys + ix + 1, keys + keys_.Size(), keys + ix);
+        keys_.PopBack();
+        return true;
+    }
+
+    void Clear() noexcept{
+        keys_.Clear();
+    }
+
+    /**
+     * the sorted keys.
+     */
+    const VLVector<K, StaticCapacity>& Keys() const noexcept{
+        return keys_;
+    }
+
+    const K& At(const size_t index) const noexcept{
+        return keys_.Data()[index];
+    }
+};
+
+#endif // VL_FLAT_MAP_H_
@@ -0,0 +1,121 @@
+#ifndef VL_HASH_H_
+#define VL_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * a wyhash style byte hash.
+ * it is not cryptographic, it is built to be fast on the short keys we use
+ * (identifiers, tenant names) while still mixing long inputs 48 bytes at a time.
+ */
+
+#define VL_HASH_SEED 0xa0761d6478bd642fULL
+#define VL_HASH_P0 0xa0761d6478bd642fULL
+#define VL_HASH_P1 0xe7037ed1a0b428dbULL
+#define VL_HASH_P2 0x8ebc6af09c88c6e3ULL
+#define VL_HASH_P3 0x589965cc75374cc3ULL
+
+/**
+ * full 64x64 -> 128 bit multiplication.
+ * @param a gets the low half of the product
+ * @param b gets the high half of the product
+ */
+inline void VLHashMultiply(uint64_t &a, uint64_t &b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t) a * b;
+    a = (uint64_t) product;
+    b = (uint64_t) (product >> 64);
+#else
+    uint64_t a_hi = a >> 32, a_lo = (uint32_t) a;
+    uint64_t b_hi = b >> 32, b_lo = (uint32_t) b;
+    uint64_t hh = a_hi * b_hi, hl = a_hi * b_lo, lh = a_lo * b_hi, ll = a_lo * b_lo;
+    uint64_t mid = (ll >> 32) + (uint32_t) hl + (uint32_t) lh;
+    a = (mid << 32) | (uint32_t) ll;
+    b = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+#endif
+}
+
+/**
+ * multiplies and folds the two halves of the product together.
+ * @return low half ^ high half
+ */
+inline uint64_t VLHashMix(uint64_t a, uint64_t b) noexcept {
+    VLHashMultiply(a, b);
+    return a ^ b;
+}
+
+inline uint64_t VLHashRead64(const unsigned char *p) noexcept {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t VLHashRead32(const unsigned char *p) noexcept {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * hashes len bytes starting at key.
+ * @param key
+ * @param len
+ * @param seed
+ * @return 64 bit hash
+ */
+inline uint64_t VLHashBytes(const void *key, size_t len, uint64_t seed = VL_HASH_SEED) noexcept {
+    const unsigned char *p = static_cast<const unsigned char *>(key);
+    uint64_t a, b;
+    seed ^= VLHashMix(seed ^ VL_HASH_P0, VL_HASH_P1);
+    if (len <= 16){
+        if (len >= 4){
+            size_t shift = (len >> 3) << 2; // 0 for 4-7 bytes, 4 for 8-16 bytes
+            a = (VLHashRead32(p) << 32) | VLHashRead32(p + shift);
+            b = (VLHashRead32(p + len - 4) << 32) | VLHashRead32(p + len - 4 - shift);
+        } else if (len > 0){
+            a = ((uint64_t) p[0] << 16) | ((uint64_t) p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t left = len;
+        if (left > 48){
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = VLHashMix(VLHashRead64(p) ^ VL_HASH_P1, VLHashRead64(p + 8) ^ seed);
+                see1 = VLHashMix(VLHashRead64(p + 16) ^ VL_HASH_P2, VLHashRead64(p + 24) ^ see1);
+                see2 = VLHashMix(VLHashRead64(p + 32) ^ VL_HASH_P3, VLHashRead64(p + 40) ^ see2);
+                p += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (left > 16){
+            seed = VLHashMix(VLHashRead64(p) ^ VL_HASH_P1, VLHashRead64(p + 8) ^ seed);
+            p += 16;
+            left -= 16;
+        }
+        // the last 16 bytes may overlap with the ones we already mixed, that is fine.
+        a = VLHashRead64(p + left - 16);
+        b = VLHashRead64(p + left - 8);
+    }
+    a ^= VL_HASH_P1;
+    b ^= seed;
+    VLHashMultiply(a, b);
+    return VLHashMix(a ^ VL_HASH_P0 ^ len, b ^ VL_HASH_P1);
+}
+
+/**
+ * combines a running hash with the hash of the next element.
+ * @param seed
+ * @param value
+ * @return
+ */
+inline uint64_t VLHashCombine(uint64_t seed, uint64_t value) noexcept {
+    return VLHashMix(seed ^ value, VL_HASH_P1);
+}
+
+#endif // VL_HASH_H_
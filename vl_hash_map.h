@@ -0,0 +1,373 @@
+#ifndef VL_HASH_MAP_H_
+#define VL_HASH_MAP_H_
+
+#ifndef START_CAP
+#include "vl_vector.h"
+#endif
+#include "vl_swar.h"
+
+#define HASH_MAP_GROUP 8
+#define HASH_MAP_EMPTY 0x80
+
+
+/**
+ * an open addressing hash map whose first StaticCapacity slots live inside the object,
+ * the same way VLVector keeps static_data_. it only allocates when it grows past them.
+ * every slot has a control byte: HASH_MAP_EMPTY, or 7 bits of the key hash when full.
+ * a lookup loads 8 control bytes as one word and matches all of them against the hash
+ * bits at once (vl_swar.h), so keys are only compared on a likely hit.
+ * probing is linear and erase shifts the following entries back, so there are no tombstones
+ * and a miss stops at the first group with an empty slot.
+ * the control array repeats its first 8 bytes after the end, so a group never wraps.
+ * @tparam K
+ * @tparam V
+ * @tparam StaticCapacity a power of two, at least 8
+ * @tparam Hash a transparent Hash (is_transparent) enables Find / Contains with other key types
+ * @tparam KeyEqual
+ */
+template<class K, class V, size_t StaticCapacity = START_CAP,
+         class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class VLHashMap{
+
+    static_assert(StaticCapacity >= HASH_MAP_GROUP && (StaticCapacity & (StaticCapacity - 1)) == 0,
+                  "VLHashMap needs a power of two StaticCapacity of at least 8");
+
+    K static_keys_[StaticCapacity];
+    V static_values_[StaticCapacity];
+    unsigned char static_ctrl_[StaticCapacity + HASH_MAP_GROUP];
+    K *keys_;
+    V *values_;
+    unsigned char *ctrl_;
+    size_t size_;
+    size_t cap_;
+    bool is_alloc_;
+    Hash hash_;
+    KeyEqual equal_;
+
+    /**
+     * std::hash of integers is often the identity, mix it so both the low bits (the home slot)
+     * and the top 7 bits (the control byte) are usable.
+     */
+    template<class Q>
+    uint64_t HashOf(const Q &key) const{
+        return VLHashMix((uint64_t) hash_(key) ^ VL_HASH_P0, VL_HASH_P1);
+    }
+
+    static unsigned char H2(const uint64_t hash) noexcept{
+        return (unsigned char) (hash >> 57);
+    }
+
+    size_t Home(const uint64_t hash) const noexcept{
+        return (size_t) hash & (cap_ - 1);
+    }
+
+    void SetCtrl(const size_t ix, const unsigned char value) noexcept{
+        ctrl_[ix] = value;
+        if (ix < HASH_MAP_GROUP){
+            ctrl_[ix + cap_] = value;
+        }
+    }
+
+    void PointAtStatic() noexcept{
+        keys_ = static_keys_;
+        values_ = static_values_;
+        ctrl_ = static_ctrl_;
+        cap_ = StaticCapacity;
+        is_alloc_ = false;
+        memset(static_ctrl_, HASH_MAP_EMPTY, sizeof(static_ctrl_));
+    }
+
+    void Release() noexcept{
+        if (is_alloc_){
+            delete[] keys_;
+            delete[] values_;
+            delete[] ctrl_;
+        }
+    }
+
+    /**
+     * @return slot of key, or cap_ if it is missing
+     */
+    template<class Q>
+    size_t FindSlot(const Q &key, const uint64_t hash) const{
+        unsigned char h2 = H2(hash);
+        size_t pos = Home(hash);
+        while (true){
+            uint64_t group = SwarLoad(ctrl_ + pos);
+            for (uint64_t match = SwarEqualBytes(group, h2) ; match != 0 ; match &= match - 1){
+                size_t ix = (pos + SwarLowestByte(match)) & (cap_ - 1);
+                if (equal_(keys_[ix], key)){
+                    return ix;
+                }
+            }
+            if (group & SWAR_HIGHS){ // an empty slot ends the probe
+                return cap_;
+            }
+            pos = (pos + HASH_MAP_GROUP) & (cap_ - 1);
+        }
+    }
+
+    /**
+     * @return the first empty slot on the probe sequence of hash
+     */
+    size_t FindEmpty(const uint64_t hash) const noexcept{
+        size_t pos = Home(hash);
+        while (true){
+            uint64_t empty = SwarLoad(ctrl_ + pos) & SWAR_HIGHS;
+            if (empty != 0){
+                return (pos + SwarFirstByte(empty)) & (cap_ - 1);
+            }
+            pos = (pos + HASH_MAP_GROUP) & (cap_ - 1);
+        }
+    }
+
+    /**
+     * doubles the table, moving every entry to its new slot.
+     */
+    void Rehash(){
+        K *old_keys = keys_;
+        V *old_values = values_;
+        unsigned char *old_ctrl = ctrl_;
+        size_t old_cap = cap_;
+        bool old_alloc = is_alloc_;
+        cap_ = old_cap * 2;
+        keys_ = new K[cap_];
+        values_ = new V[cap_];
+        ctrl_ = new unsigned char[cap_ + HASH_MAP_GROUP];
+        memset(ctrl_, HASH_MAP_EMPTY, cap_ + HASH_MAP_GROUP);
+        is_alloc_ = true;
+        for (size_t ix = 0 ; ix < old_cap ; ix++){
+            if (old_ctrl[ix] & HASH_MAP_EMPTY) {continue;}
+            uint64_t hash = HashOf(old_keys[ix]);
+            size_t slot = FindEmpty(hash);
+            SetCtrl(slot, H2(hash));
+            keys_[slot] = std::move(old_keys[ix]);
+            values_[slot] = std::move(old_values[ix]);
+        }
+        if (old_alloc){
+            delete[] old_keys;
+            delete[] old_values;
+            delete[] old_ctrl;
+        } else {
+            for (size_t ix = 0 ; ix < StaticCapacity ; ix++){ // let go of what the moved from items hold
+                static_keys_[ix] = K();
+                static_values_[ix] = V();
+            }
+        }
+    }
+
+    /**
+     * puts a new key (known to be missing) in the table, growing past 7/8 load.
+     * key is taken by copy, it may refer into the table and Rehash frees or resets it.
+     * @return its slot
+     */
+    size_t InsertNew(K key, uint64_t hash){
+        if ((size_ + 1) * 8 > cap_ * 7){
+            Rehash();
+        }
+        size_t slot = FindEmpty(hash);
+        SetCtrl(slot, H2(hash));
+        keys_[slot] = std::move(key);
+        size_++;
+        return slot;
+    }
+
+    /**
+     * empties slot ix, then walks the run after it and moves back every entry
+     * whose home is not between the hole and its current slot.
+     */
+    void EraseSlot(size_t ix){
+        size_t mask = cap_ - 1;
+        size_t next = (ix + 1) & mask;
+        while (!(ctrl_[next] & HASH_MAP_EMPTY)){
+            size_t home = Home(HashOf(keys_[next]));
+            // can next move to ix? only if home is cyclically outside (ix, next]
+            if (((next - home) & mask) >= ((next - ix) & mask)){
+                SetCtrl(ix, ctrl_[next]);
+                keys_[ix] = std::move(keys_[next]);
+                values_[ix] = std::move(values_[next]);
+                ix = next;
+            }
+            next = (next + 1) & mask;
+        }
+        SetCtrl(ix, HASH_MAP_EMPTY);
+        keys_[ix] = K();
+        values_[ix] = V();
+        size_--;
+    }
+
+    void CopyFrom(const VLHashMap &rhs){
+        if (rhs.is_alloc_){
+            cap_ = rhs.cap_;
+            keys_ = new K[cap_];
+            values_ = new V[cap_];
+            ctrl_ = new unsigned char[cap_ + HASH_MAP_GROUP];
+            is_alloc_ = true;
+        }
+        std::copy(rhs.keys_, rhs.keys_ + cap_, keys_);
+        std::copy(rhs.values_, rhs.values_ + cap_, values_);
+        memcpy(ctrl_, rhs.ctrl_, cap_ + HASH_MAP_GROUP);
+        size_ = rhs.size_;
+    }
+
+    public:
+
+    VLHashMap(): size_(0), hash_(), equal_() {
+        PointAtStatic();
+    }
+
+    VLHashMap(const VLHashMap &rhs): size_(0), hash_(rhs.hash_), equal_(rhs.equal_) {
+        PointAtStatic();
+        CopyFrom(rhs);
+    }
+
+    VLHashMap &operator=(const VLHashMap &rhs){
+        if (this != &rhs){
+            Release();
+            PointAtStatic();
+            CopyFrom(rhs);
+        }
+        return *this;
+    }
+
+    ~VLHashMap(){
+        Release();
+    }
+
+    size_t Size() const noexcept{
+        return size_;
+    }
+
+    bool Empty() const noexcept{
+        return size_ == 0;
+    }
+
+    /**
+     * @return number of slots, StaticCapacity until the map spills to the heap
+     */
+    size_t Capacity() const noexcept{
+        return cap_;
+    }
+
+    /**
+     * @return pointer to the value of key, nullptr if it is missing. valid until the next change.
+     */
+    V* Find(const K &key){
+        size_t slot = FindSlot(key, HashOf(key));
+        return slot == cap_ ? nullptr : values_ + slot;
+    }
+
+    const V* Find(const K &key) const{
+        size_t slot = FindSlot(key, HashOf(key));
+        return slot == cap_ ? nullptr : values_ + slot;
+    }
+
+    /**
+     * heterogeneous lookup, e.g. a VLStringView in a map keyed by VLString with VLStringHash.
+     * Hash and KeyEqual must agree on Q and K.
+     */
+    template<class Q, class H = Hash, class = typename H::is_transparent>
+    V* Find(const Q &key){
+        size_t slot = FindSlot(key, HashOf(key));
+        return slot == cap_ ? nullptr : values_ + slot;
+    }
+
+    template<class Q, class H = Hash, class = typename H::is_transparent>
+    const V* Find(const Q &key) const{
+        size_t slot = FindSlot(key, HashOf(key));
+        return slot == cap_ ? nullptr : values_ + slot;
+    }
+
+    bool Contains(const K &key) const{
+        return Find(key) != nullptr;
+    }
+
+    template<class Q, class H = Hash, class = typename H::is_transparent>
+    bool Contains(const Q &key) const{
+        return Find(key) != nullptr;
+    }
+
+    /**
+     * @return false if key was already there, its value is kept then
+     */
+    bool Insert(const K &key, const V &value){
+        uint64_t hash = HashOf(key);
+        if (FindSlot(key, hash) != cap_){
+            return false;
+        }
+        V copy = value; // value may live in the table, which InsertNew can rehash
+        size_t slot = InsertNew(key, hash); // may move values_, so not in the same expression
+        values_[slot] = std::move(copy);
+        return true;
+    }
+
+    /**
+     * @return true if key is new, false if its value was replaced
+     */
+    bool InsertOrAssign(const K &key, const V &value){
+        uint64_t hash = HashOf(key);
+        size_t slot = FindSlot(key, hash);
+        if (slot != cap_){
+            values_[slot] = value;
+            return false;
+        }
+        V copy = value; // value may live in the table, which InsertNew can rehash
+        slot = InsertNew(key, hash);
+        values_[slot] = std::move(copy);
+        return true;
+    }
+
+    /**
+     * @return the value of key, inserting a default one first if it is missing
+     */
+    V& operator[](const K &key){
+        uint64_t hash = HashOf(key);
+        size_t slot = FindSlot(key, hash);
+        if (slot == cap_){
+            slot = InsertNew(key, hash);
+            values_[slot] = V();
+        }
+        return values_[slot];
+    }
+
+    /**
+     * @return false if key was not there
+     */
+    bool Erase(const K &key){
+        size_t slot = FindSlot(key, HashOf(key));
+        if (slot == cap_){
+            return false;
+        }
+        EraseSlot(slot);
+        return true;
+    }
+
+    /**
+     * removes every entry and goes back to the inline slots.
+     */
+    void Clear(){
+        Release();
+        PointAtStatic();
+        for (size_t ix = 0 ; ix < StaticCapacity ; ix++){
+            static_keys_[ix] = K();
+            static_values_[ix] = V();
+        }
+        size_ = 0;
+    }
+
+    /**
+     * calls func(const K&, V&) on every entry, in slot order.
+     * @tparam Func
+     * @param func
+     */
+    template<class Func>
+    void ForEach(Func func){
+        for (size_t ix = 0 ; ix < cap_ ; ix++){
+            if (!(ctrl_[ix] & HASH_MAP_EMPTY)){
+                func((const K&) keys_[ix], values_[ix]);
+            }
+        }
+    }
+};
+
+#endif // VL_HASH_MAP_H_
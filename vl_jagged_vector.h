@@ -0,0 +1,203 @@
+#ifndef VL_JAGGED_VECTOR_H_
+#define VL_JAGGED_VECTOR_H_
+
+#include "vl_span.h"
+
+
+/**
+ * many short rows (adjacency lists, posting lists) flattened into one values VLVector.
+ * row i starts at offsets_[i] and holds lengths_[i] values, so a row costs two words
+ * instead of a whole inner vector, and walking every row streams through one array.
+ * EraseFromRow leaves slack at the end of its row instead of shifting the rows after it,
+ * Compact() squeezes the slack out.
+ * @tparam T
+ * @tparam StaticCapacity inline values (and rows) before spilling to the heap
+ */
+template<class T, size_t StaticCapacity = START_CAP>
+class VLJaggedVector{
+
+    VLVector<T, StaticCapacity> values_;
+    VLVector<size_t, StaticCapacity> offsets_;
+    VLVector<size_t, StaticCapacity> lengths_;
+    size_t size_; // live values, values_ also holds the slack
+
+    void CheckRow(const size_t row) const{
+        if (row >= offsets_.Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+    }
+
+    public:
+
+    VLJaggedVector(): size_(0) {}
+
+    /**
+     * @return number of rows
+     */
+    size_t RowCount() const noexcept{
+        return offsets_.Size();
+    }
+
+    /**
+     * @return number of values in all rows
+     */
+    size_t Size() const noexcept{
+        return size_;
+    }
+
+    bool Empty() const noexcept{
+        return offsets_.Empty();
+    }
+
+    /**
+     * adds a row holding [first, last).
+     * the iterators must not point into this vector, pointer ranges (which may) go to the overloads below.
+     * @tparam InputIterator
+     * @param first
+     * @param last
+     */
+    template<class InputIterator>
+    void AppendRow(InputIterator first, InputIterator last){
+        size_t start = values_.Size();
+        for (; first != last ; ++first){
+            values_.PushBack(*first);
+        }
+        offsets_.PushBack(start);
+        lengths_.PushBack(values_.Size() - start);
+        size_ += values_.Size() - start;
+    }
+
+    /**
+     * pointer ranges, the row of this vector included, take the one growth path below.
+     * without these, a T* range would pick the iterator template, whose PushBack can
+     * reallocate under it.
+     */
+    void AppendRow(const T *first, const T *last){
+        AppendRow(VLSpan<const T>(first, last - first));
+    }
+
+    void AppendRow(T *first, T *last){
+        AppendRow(VLSpan<const T>(first, last - first));
+    }
+
+    /**
+     * adds a copy of row as a new row, with one growth.
+     * row may be one of this vector's rows, it is found again after the growth.
+     */
+    void AppendRow(const VLSpan<const T> row){
+        const T *values = values_.Data();
+        bool aliased = !std::less<const T*>()(row.begin(), values)
+                       && std::less<const T*>()(row.begin(), values + values_.Size());
+        size_t offset = aliased ? row.begin() - values : 0;
+        T *dest = values_.Grow(row.Size());
+        const T *first = aliased ? values_.Data() + offset : row.begin();
+        std::copy(first, first + row.Size(), dest);
+        offsets_.PushBack(values_.Size() - row.Size());
+        lengths_.PushBack(row.Size());
+        size_ += row.Size();
+    }
+
+    /**
+     * @param row below RowCount()
+     * @return the values of row, valid until the next change
+     */
+    VLSpan<T> Row(const size_t row){
+        CheckRow(row);
+        return VLSpan<T>(values_.Data() + offsets_[row], lengths_[row]);
+    }
+
+    VLSpan<const T> Row(const size_t row) const{
+        CheckRow(row);
+        return VLSpan<const T>(values_.Data() + offsets_.Data()[row], lengths_.Data()[row]);
+    }
+
+    /**
+     * replaces the content with rows rows built from (row, value) pairs, in O(rows + pairs).
+     * a counting sort: one pass counts the values of every row, the prefix sums become the
+     * offsets, a second pass puts every value in place. values keep their order within a row.
+     * @tparam ForwardIterator iterates over std::pair<size_t, T> (or anything with first / second)
+     * @param first
+     * @param last
+     * @param rows every pair's row must be below it,
+     * otherwise std::out_of_range is thrown and the vector is left empty
+     */
+    template<class ForwardIterator>
+    void Build(ForwardIterator first, ForwardIterator last, const size_t rows){
+        Clear();
+        size_t *counts = lengths_.Grow(rows);
+        std::fill(counts, counts + rows, 0);
+        size_t total = 0;
+        for (ForwardIterator it = first ; it != last ; ++it){
+            if ((size_t) it->first >= rows){
+                Clear();
+                throw std::out_of_range (BAD_INDEX);
+            }
+            counts[it->first]++;
+            total++;
+        }
+        size_t *offsets = offsets_.Grow(rows);
+        size_t next = 0;
+        for (size_t row = 0 ; row < rows ; row++){
+            offsets[row] = next;
+            next += counts[row];
+        }
+        T *values = values_.Grow(total);
+        std::fill(counts, counts + rows, 0); // reused as the fill position of every row
+        for (ForwardIterator it = first ; it != last ; ++it){
+            values[offsets[it->first] + counts[it->first]++] = it->second;
+        }
+        size_ = total;
+    }
+
+    /**
+     * removes the value at index of row, shifting only the rest of that row.
+     * the row keeps the freed slot as slack until Compact().
+     * @param row
+     * @param index
+     */
+    void EraseFromRow(const size_t row, const size_t index){
+        CheckRow(row);
+        if (index >= lengths_[row]){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        T *begin = values_.Data() + offsets_[row];
+        std::move(begin + index + 1, begin + lengths_[row], begin + index);
+        lengths_[row]--;
+        size_--;
+    }
+
+    /**
+     * @return values stored as slack, freed by Compact()
+     */
+    size_t Slack() const noexcept{
+        return values_.Size() - size_;
+    }
+
+    /**
+     * moves every row down over the slack before it, in one pass, and drops the freed tail.
+     */
+    void Compact(){
+        T *values = values_.Data();
+        size_t next = 0;
+        for (size_t row = 0 ; row < offsets_.Size() ; row++){
+            size_t start = offsets_[row];
+            if (start != next){
+                std::move(values + start, values + start + lengths_[row], values + next);
+                offsets_[row] = next;
+            }
+            next += lengths_[row];
+        }
+        while (values_.Size() > next){
+            values_.PopBack();
+        }
+    }
+
+    void Clear() noexcept{
+        values_.Clear();
+        offsets_.Clear();
+        lengths_.Clear();
+        size_ = 0;
+    }
+};
+
+#endif // VL_JAGGED_VECTOR_H_
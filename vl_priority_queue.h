@@ -0,0 +1,222 @@
+#ifndef VL_PRIORITY_QUEUE_H_
+#define VL_PRIORITY_QUEUE_H_
+
+#ifndef START_CAP
+#include "vl_vector.h"
+#endif
+#include <stdexcept>
+
+#define NOT_IN_HEAP ((size_t) -1)
+#define BAD_HANDLE "handle not in the queue.\n"
+
+
+/**
+ * a priority queue kept as an Arity-ary heap in a VLVector.
+ * a wider node means a shallower tree: a 4-ary heap of a thousand items is 5 levels deep,
+ * and the children of a node sit next to each other, usually in one cache line.
+ * the first StaticCapacity items live inline, so small queues never allocate.
+ * like std::priority_queue, Top() is the largest item under Compare.
+ * Push hands out a handle, which stays valid until its item is popped, for DecreaseKey.
+ * @tparam T
+ * @tparam StaticCapacity
+ * @tparam Compare
+ * @tparam Arity at least 2
+ */
+template<class T, size_t StaticCapacity = START_CAP, class Compare = std::less<T>, size_t Arity = 4>
+class VLPriorityQueue{
+
+    static_assert(Arity >= 2, "a heap node needs at least two children");
+
+    public:
+    typedef size_t Handle;
+
+    private:
+    struct Node{
+        T value;
+        Handle handle;
+    };
+
+    VLVector<Node, StaticCapacity> heap_;
+    VLVector<size_t, StaticCapacity> positions_; // heap index of every handle, NOT_IN_HEAP when free
+    VLVector<Handle, StaticCapacity> free_handles_;
+    Compare less_;
+
+    void Place(const size_t pos, const Node &node) noexcept{
+        heap_[pos] = node;
+        positions_[node.handle] = pos;
+    }
+
+    /**
+     * moves node up from pos while it beats its parent.
+     */
+    void SiftUp(size_t pos, const Node node){
+        while (pos > 0){
+            size_t parent = (pos - 1) / Arity;
+            if (!less_(heap_[parent].value, node.value)){
+                break;
+            }
+            Place(pos, heap_[parent]);
+            pos = parent;
+        }
+        Place(pos, node);
+    }
+
+    /**
+     * moves node down from pos while one of its children beats it.
+     */
+    void SiftDown(size_t pos, const Node node){
+        size_t size = heap_.Size();
+        while (true){
+            size_t first = pos * Arity + 1;
+            if (first >= size) {break;}
+            size_t last = first + Arity < size ? first + Arity : size;
+            size_t best = first;
+            for (size_t child = first + 1 ; child < last ; child++){
+                if (less_(heap_[best].value, heap_[child].value)){
+                    best = child;
+                }
+            }
+            if (!less_(node.value, heap_[best].value)){
+                break;
+            }
+            Place(pos, heap_[best]);
+            pos = best;
+        }
+        Place(pos, node);
+    }
+
+    Handle NewHandle(){
+        if (!free_handles_.Empty()){
+            Handle handle = free_handles_[free_handles_.Size() - 1];
+            free_handles_.PopBack();
+            return handle;
+        }
+        positions_.PushBack(NOT_IN_HEAP);
+        return positions_.Size() - 1;
+    }
+
+    size_t PositionOf(const Handle handle) const{
+        if (handle >= positions_.Size() || positions_[handle] == NOT_IN_HEAP){
+            throw std::out_of_range (BAD_HANDLE);
+        }
+        return positions_[handle];
+    }
+
+    public:
+
+    VLPriorityQueue(): less_() {}
+
+    explicit VLPriorityQueue(const Compare &less): less_(less) {}
+
+    size_t Size() const noexcept{
+        return heap_.Size();
+    }
+
+    bool Empty() const noexcept{
+        return heap_.Empty();
+    }
+
+    /**
+     * adds value, O(log n / log Arity).
+     * @return a handle for DecreaseKey / Get
+     */
+    Handle Push(const T &value){
+        Node node;
+        node.value = value;
+        node.handle = NewHandle();
+        heap_.Grow(1);
+        SiftUp(heap_.Size() - 1, node);
+        return node.handle;
+    }
+
+    /**
+     * @return the largest item, the queue must not be empty
+     */
+    const T& Top() const noexcept{
+        return heap_.Data()[0].value;
+    }
+
+    Handle TopHandle() const noexcept{
+        return heap_.Data()[0].handle;
+    }
+
+    /**
+     * removes the top item and frees its handle, does nothing if empty.
+     */
+    void Pop(){
+        if (heap_.Empty()) {return;}
+        Handle top = heap_[0].handle;
+        Node last = heap_[heap_.Size() - 1];
+        heap_.PopBack();
+        if (!heap_.Empty()){
+            SiftDown(0, last);
+        }
+        positions_[top] = NOT_IN_HEAP;
+        free_handles_.PushBack(top);
+    }
+
+    bool Contains(const Handle handle) const noexcept{
+        return handle < positions_.Size() && positions_[handle] != NOT_IN_HEAP;
+    }
+
+    /**
+     * @return the item of handle
+     */
+    const T& Get(const Handle handle) const{
+        return heap_.Data()[PositionOf(handle)].value;
+    }
+
+    /**
+     * replaces the item of handle with value and restores the heap, moving it up or down.
+     * with std::less, lowering a key moves it down and raising it moves it up.
+     * throws std::out_of_range if handle is not in the queue.
+     * @param handle
+     * @param value
+     */
+    void DecreaseKey(const Handle handle, const T &value){
+        size_t pos = PositionOf(handle);
+        Node node;
+        node.value = value;
+        node.handle = handle;
+        if (pos > 0 && less_(heap_[(pos - 1) / Arity].value, value)){
+            SiftUp(pos, node);
+        } else {
+            SiftDown(pos, node);
+        }
+    }
+
+    /**
+     * replaces the content with [first, last) in O(n), bottom up.
+     * the k-th item of the range gets handle k.
+     * @tparam InputIterator
+     * @param first
+     * @param last
+     */
+    template<class InputIterator>
+    void Heapify(InputIterator first, InputIterator last){
+        Clear();
+        for (; first != last ; ++first){
+            Node node;
+            node.value = *first;
+            node.handle = heap_.Size();
+            heap_.PushBack(node);
+            positions_.PushBack(node.handle);
+        }
+        for (size_t pos = heap_.Size() / Arity + 1 ; pos-- > 0 ;){
+            if (pos < heap_.Size()){
+                SiftDown(pos, heap_[pos]);
+            }
+        }
+    }
+
+    /**
+     * empties the queue, every handle becomes invalid.
+     */
+    void Clear() noexcept{
+        heap_.Clear();
+        positions_.Clear();
+        free_handles_.Clear();
+    }
+};
+
+#endif // VL_PRIORITY_QUEUE_H_
@@ -0,0 +1,308 @@
+#ifndef VL_RING_BUFFER_H_
+#define VL_RING_BUFFER_H_
+
+#include "vl_span.h"
+
+
+/**
+ * the circular indexing shared by VLRingBuffer and VLDeque.
+ * size_ items start at data_[head_] and wrap around after cap_ items.
+ * the owner provides the buffer. pushes assume there is room, the owners check or grow first.
+ * @tparam T
+ */
+template<class T>
+class VLRingBase{
+
+protected:
+    T *data_;
+    size_t cap_;
+    size_t head_;
+    size_t size_;
+
+    VLRingBase(T *data, const size_t cap): data_(data), cap_(cap), head_(0), size_(0) {}
+
+    /**
+     * @return buffer position of the item at logical index, without a division
+     */
+    size_t Slot(const size_t index) const noexcept{
+        size_t slot = head_ + index;
+        return slot >= cap_ ? slot - cap_ : slot;
+    }
+
+    void PushBackUnchecked(const T &value){
+        data_[Slot(size_)] = value;
+        size_++;
+    }
+
+    void PushFrontUnchecked(const T &value){
+        head_ = head_ == 0 ? cap_ - 1 : head_ - 1;
+        data_[head_] = value;
+        size_++;
+    }
+
+    /**
+     * copies the items, in order, to dest with at most two copies.
+     */
+    void CopyOut(T *dest) const{
+        VLSpan<const T> first = FirstSpan();
+        VLSpan<const T> second = SecondSpan();
+        std::copy(first.begin(), first.end(), dest);
+        std::copy(second.begin(), second.end(), dest + first.Size());
+    }
+
+    public:
+
+    size_t Size() const noexcept{
+        return size_;
+    }
+
+    bool Empty() const noexcept{
+        return size_ == 0;
+    }
+
+    size_t Capacity() const noexcept{
+        return cap_;
+    }
+
+    T& operator[](const size_t index) noexcept{
+        return data_[Slot(index)];
+    }
+
+    const T& operator[](const size_t index) const noexcept{
+        return data_[Slot(index)];
+    }
+
+    T& At(const size_t index){
+        if (index >= size_){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        return data_[Slot(index)];
+    }
+
+    const T& At(const size_t index) const{
+        if (index >= size_){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        return data_[Slot(index)];
+    }
+
+    T& Front() noexcept{
+        return data_[head_];
+    }
+
+    T& Back() noexcept{
+        return data_[Slot(size_ - 1)];
+    }
+
+    /**
+     * the items from the front up to the end of the buffer (or to the last item).
+     * FirstSpan() followed by SecondSpan() is the whole content in order.
+     */
+    VLSpan<const T> FirstSpan() const noexcept{
+        size_t len = size_ < cap_ - head_ ? size_ : cap_ - head_;
+        return VLSpan<const T>(data_ + head_, len);
+    }
+
+    /**
+     * the items that wrapped around to the start of the buffer, empty if none did.
+     */
+    VLSpan<const T> SecondSpan() const noexcept{
+        size_t len = size_ < cap_ - head_ ? 0 : size_ - (cap_ - head_);
+        return VLSpan<const T>(data_, len);
+    }
+};
+
+
+/**
+ * a fixed size FIFO / LIFO of up to Capacity items, all inline.
+ * pushes and pops at both ends are O(1) and never move the other items.
+ * pushing to a full buffer fails instead of growing.
+ * @tparam T
+ * @tparam Capacity
+ */
+template<class T, size_t Capacity>
+class VLRingBuffer : public VLRingBase<T>{
+
+    static_assert(Capacity > 0, "VLRingBuffer needs room for at least one item");
+
+    T static_data_[Capacity];
+
+    public:
+
+    VLRingBuffer(): VLRingBase<T>(static_data_, Capacity) {}
+
+    VLRingBuffer(const VLRingBuffer &rhs): VLRingBase<T>(static_data_, Capacity) {
+        rhs.CopyOut(static_data_);
+        this->size_ = rhs.size_;
+    }
+
+    VLRingBuffer &operator=(const VLRingBuffer &rhs){
+        if (this != &rhs){
+            rhs.CopyOut(static_data_);
+            this->head_ = 0;
+            this->size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    bool Full() const noexcept{
+        return this->size_ == Capacity;
+    }
+
+    /**
+     * @return false if the buffer is full, nothing is added then
+     */
+    bool PushBack(const T &value){
+        if (Full()) {return false;}
+        this->PushBackUnchecked(value);
+        return true;
+    }
+
+    bool PushFront(const T &value){
+        if (Full()) {return false;}
+        this->PushFrontUnchecked(value);
+        return true;
+    }
+
+    /**
+     * removes the first item, does nothing if empty.
+     */
+    void PopFront() noexcept{
+        if (this->size_ == 0) {return;}
+        this->head_ = this->Slot(1);
+        this->size_--;
+    }
+
+    void PopBack() noexcept{
+        if (this->size_ == 0) {return;}
+        this->size_--;
+    }
+
+    void Clear() noexcept{
+        this->head_ = 0;
+        this->size_ = 0;
+    }
+};
+
+
+/**
+ * a double ended queue with O(1) pushes and pops at both ends.
+ * the first StaticCapacity items live inline, like VLVector, and it grows to the heap
+ * by REFACTOR_RATIO. growing or going back to the stack unwraps the items to the start.
+ * @tparam T
+ * @tparam StaticCapacity
+ */
+template<class T, size_t StaticCapacity = START_CAP>
+class VLDeque : public VLRingBase<T>{
+
+    T static_data_[StaticCapacity];
+    bool is_alloc_;
+
+    /**
+     * moves the items to a new buffer of new_cap slots, unwrapped. new_cap == StaticCapacity means the stack.
+     */
+    void Reallocate(const size_t new_cap){
+        T *new_data = new_cap == StaticCapacity ? static_data_ : new T[new_cap];
+        this->CopyOut(new_data);
+        if (is_alloc_){
+            delete[] this->data_;
+        }
+        is_alloc_ = new_data != static_data_;
+        this->data_ = new_data;
+        this->cap_ = new_cap;
+        this->head_ = 0;
+    }
+
+    void ResizeUp(){
+        if (this->size_ < this->cap_) {return;}
+        Reallocate(floor(REFACTOR_RATIO * (this->size_ + 1)));
+    }
+
+    /**
+     * back to the inline buffer once the items fit in it again, like VLVector::ResizeDown,
+     * but only when they also fill at most 1 / REFACTOR_RATIO^2 of the heap buffer.
+     * without that gap a queue hovering around StaticCapacity items would move between
+     * the stack and the heap on every push and pop.
+     */
+    void ResizeDown(){
+        if (is_alloc_ && this->size_ <= StaticCapacity
+            && this->size_ * REFACTOR_RATIO * REFACTOR_RATIO <= this->cap_){
+            Reallocate(StaticCapacity);
+        }
+    }
+
+    public:
+
+    VLDeque(): VLRingBase<T>(static_data_, StaticCapacity), is_alloc_(false) {}
+
+    VLDeque(const VLDeque &rhs): VLRingBase<T>(static_data_, StaticCapacity), is_alloc_(false) {
+        *this = rhs;
+    }
+
+    VLDeque &operator=(const VLDeque &rhs){
+        if (this == &rhs) {return *this;}
+        if (is_alloc_){
+            delete[] this->data_;
+        }
+        is_alloc_ = rhs.is_alloc_;
+        this->cap_ = rhs.cap_;
+        this->data_ = is_alloc_ ? new T[this->cap_] : static_data_;
+        rhs.CopyOut(this->data_);
+        this->head_ = 0;
+        this->size_ = rhs.size_;
+        return *this;
+    }
+
+    ~VLDeque(){
+        if (is_alloc_){
+            delete[] this->data_;
+        }
+    }
+
+    /**
+     * value is copied before growing, it may be an item of this deque.
+     */
+    void PushBack(const T &value){
+        T copy = value;
+        ResizeUp();
+        this->PushBackUnchecked(copy);
+    }
+
+    void PushFront(const T &value){
+        T copy = value;
+        ResizeUp();
+        this->PushFrontUnchecked(copy);
+    }
+
+    /**
+     * removes the first item, does nothing if empty.
+     */
+    void PopFront(){
+        if (this->size_ == 0) {return;}
+        this->head_ = this->Slot(1);
+        this->size_--;
+        ResizeDown();
+    }
+
+    void PopBack(){
+        if (this->size_ == 0) {return;}
+        this->size_--;
+        ResizeDown();
+    }
+
+    /**
+     * clears the deque and frees the heap buffer.
+     */
+    void Clear() noexcept{
+        if (is_alloc_){
+            delete[] this->data_;
+            is_alloc_ = false;
+        }
+        this->data_ = static_data_;
+        this->cap_ = StaticCapacity;
+        this->head_ = 0;
+        this->size_ = 0;
+    }
+};
+
+#endif // VL_RING_BUFFER_H_
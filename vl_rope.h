@@ -0,0 +1,359 @@
+#ifndef VL_ROPE_H_
+#define VL_ROPE_H_
+
+#include "vl_string.h"
+
+#define ROPE_CHUNK_SIZE 512
+#define ROPE_SEED 0x9e3779b9u
+
+
+/**
+ * large text stored as a balanced tree of bounded VLString chunks.
+ * the tree is a treap ordered by position: every node keeps the length of its subtree,
+ * so finding, inserting, erasing or splitting at a position walks one path, O(log n).
+ * a chunk holds up to ROPE_CHUNK_SIZE chars in its static buffer, so chunks never allocate.
+ */
+class VLRope{
+
+    typedef VLString<ROPE_CHUNK_SIZE + 1> Chunk; // + 1 for the \0
+
+    struct Node{
+        Chunk text;
+        size_t length; // chars in this subtree
+        uint32_t priority;
+        Node *left;
+        Node *right;
+    };
+
+    Node *root_;
+    uint32_t seed_;
+
+    static size_t Length(const Node *node) noexcept{
+        return node ? node->length : 0;
+    }
+
+    static void Update(Node *node) noexcept{
+        node->length = Length(node->left) + node->text.Size() + Length(node->right);
+    }
+
+    /**
+     * xorshift, priorities only need to look random.
+     */
+    uint32_t NextPriority() noexcept{
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 17;
+        seed_ ^= seed_ << 5;
+        return seed_;
+    }
+
+    Node* NewNode(const VLStringView text){
+        Node *node = new Node;
+        node->text.Append(text);
+        node->length = text.Size();
+        node->priority = NextPriority();
+        node->left = nullptr;
+        node->right = nullptr;
+        return node;
+    }
+
+    static void Destroy(Node *node) noexcept{
+        if (!node) {return;}
+        Destroy(node->left);
+        Destroy(node->right);
+        delete node;
+    }
+
+    static Node* Clone(const Node *node){
+        if (!node) {return nullptr;}
+        Node *ret = new Node(*node);
+        ret->left = Clone(node->left);
+        ret->right = Clone(node->right);
+        return ret;
+    }
+
+    /**
+     * joins two treaps, every char of lhs goes before every char of rhs.
+     */
+    static Node* Merge(Node *lhs, Node *rhs) noexcept{
+        if (!lhs) {return rhs;}
+        if (!rhs) {return lhs;}
+        if (lhs->priority > rhs->priority){
+            lhs->right = Merge(lhs->right, rhs);
+            Update(lhs);
+            return lhs;
+        }
+        rhs->left = Merge(lhs, rhs->left);
+        Update(rhs);
+        return rhs;
+    }
+
+    /**
+     * splits node into the first pos chars (lhs) and the rest (rhs).
+     * a chunk that straddles pos is cut in two, the tail becomes a node with a fresh priority.
+     * that priority may beat the nodes above it, so the halves coming back up are put
+     * under their new parent through Merge instead of being hung there directly.
+     */
+    void Split(Node *node, const size_t pos, Node *&lhs, Node *&rhs){
+        if (!node){
+            lhs = rhs = nullptr;
+            return;
+        }
+        size_t left_len = Length(node->left);
+        size_t text_len = node->text.Size();
+        if (pos <= left_len){
+            Node *rest;
+            Split(node->left, pos, lhs, rest);
+            node->left = nullptr;
+            Update(node);
+            rhs = Merge(rest, node);
+        } else if (pos >= left_len + text_len){
+            Node *rest;
+            Split(node->right, pos - left_len - text_len, rest, rhs);
+            node->right = nullptr;
+            Update(node);
+            lhs = Merge(node, rest);
+        } else {
+            size_t cut = pos - left_len;
+            Node *tail = NewNode(VLStringView(node->text.Data() + cut, text_len - cut));
+            node->text.Erase(cut, text_len - cut);
+            rhs = Merge(tail, node->right);
+            node->right = nullptr;
+            Update(node);
+            lhs = node;
+        }
+    }
+
+    /**
+     * moves the first chunk of rhs onto the end of the last chunk of lhs if both fit in one,
+     * so erasing does not leave a trail of small chunks behind.
+     */
+    void JoinChunks(Node *lhs, Node *&rhs){
+        if (!lhs || !rhs) {return;}
+        Node *last = lhs;
+        while (last->right){
+            last = last->right;
+        }
+        Node *first = rhs;
+        while (first->left){
+            first = first->left;
+        }
+        size_t first_len = first->text.Size();
+        if (last->text.Size() + first_len > ROPE_CHUNK_SIZE) {return;}
+        Node *head;
+        Split(rhs, first_len, head, rhs); // on a chunk boundary, head is just first
+        last->text.Append(head->text.View());
+        for (Node *node = lhs ; node ; node = node->right){
+            node->length += first_len; // every node on the right spine holds last
+        }
+        Destroy(head);
+    }
+
+    /**
+     * @return a treap of text cut into ROPE_CHUNK_SIZE pieces
+     */
+    Node* Build(const VLStringView text){
+        Node *ret = nullptr;
+        for (size_t ix = 0 ; ix < text.Size() ; ix += ROPE_CHUNK_SIZE){
+            size_t len = text.Size() - ix < ROPE_CHUNK_SIZE ? text.Size() - ix : ROPE_CHUNK_SIZE;
+            ret = Merge(ret, NewNode(VLStringView(text.Data() + ix, len)));
+        }
+        return ret;
+    }
+
+    /**
+     * inserts text into the chunk holding pos if it still fits there.
+     * @return false if it does not fit, nothing is changed then
+     */
+    static bool InsertInChunk(Node *node, const size_t pos, const VLStringView text){
+        if (!node) {return false;}
+        size_t left_len = Length(node->left);
+        size_t text_len = node->text.Size();
+        bool inserted;
+        if (pos < left_len){
+            inserted = InsertInChunk(node->left, pos, text);
+        } else if (pos > left_len + text_len){
+            inserted = InsertInChunk(node->right, pos - left_len - text_len, text);
+        } else if (text_len + text.Size() <= ROPE_CHUNK_SIZE){
+            node->text.Insert(pos - left_len, text);
+            inserted = true;
+        } else {
+            inserted = false;
+        }
+        if (inserted){
+            node->length += text.Size();
+        }
+        return inserted;
+    }
+
+    public:
+
+    VLRope(): root_(nullptr), seed_(ROPE_SEED) {}
+
+    explicit VLRope(const VLStringView text): root_(nullptr), seed_(ROPE_SEED) {
+        root_ = Build(text);
+    }
+
+    VLRope(const VLRope &rhs): root_(Clone(rhs.root_)), seed_(rhs.seed_) {}
+
+    VLRope(VLRope &&rhs) noexcept: root_(rhs.root_), seed_(rhs.seed_) {
+        rhs.root_ = nullptr;
+    }
+
+    VLRope &operator=(const VLRope &rhs){
+        if (this != &rhs){
+            Node *copy = Clone(rhs.root_);
+            Destroy(root_);
+            root_ = copy;
+        }
+        return *this;
+    }
+
+    ~VLRope(){
+        Destroy(root_);
+    }
+
+    /**
+     * @return number of chars
+     */
+    size_t Size() const noexcept{
+        return Length(root_);
+    }
+
+    bool Empty() const noexcept{
+        return root_ == nullptr;
+    }
+
+    /**
+     * @param index
+     * @return the char at index
+     */
+    char At(size_t index) const{
+        if (index >= Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        const Node *node = root_;
+        while (true){
+            size_t left_len = Length(node->left);
+            if (index < left_len){
+                node = node->left;
+            } else if (index < left_len + node->text.Size()){
+                return node->text[index - left_len];
+            } else {
+                index -= left_len + node->text.Size();
+                node = node->right;
+            }
+        }
+    }
+
+    /**
+     * inserts text before the char at pos, O(log n + text size).
+     * @param pos at most Size()
+     * @param text
+     */
+    void Insert(const size_t pos, const VLStringView text){
+        if (pos > Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        if (text.Empty() || InsertInChunk(root_, pos, text)){
+            return;
+        }
+        Node *lhs, *rhs;
+        Split(root_, pos, lhs, rhs);
+        root_ = Merge(Merge(lhs, Build(text)), rhs);
+    }
+
+    void Append(const VLStringView text){
+        Insert(Size(), text);
+    }
+
+    /**
+     * removes up to len chars starting at pos, O(log n) plus the erased chunks.
+     * the chunks left on both sides of the gap are joined if they fit in one.
+     * @param pos at most Size()
+     * @param len
+     */
+    void Erase(const size_t pos, size_t len){
+        if (pos > Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        if (len > Size() - pos){
+            len = Size() - pos;
+        }
+        Node *lhs, *mid, *rhs;
+        Split(root_, pos, lhs, mid);
+        Split(mid, len, mid, rhs);
+        Destroy(mid);
+        JoinChunks(lhs, rhs);
+        root_ = Merge(lhs, rhs);
+    }
+
+    /**
+     * keeps the first pos chars and returns the rest as a new rope, O(log n).
+     * @param pos at most Size()
+     * @return the chars from pos on
+     */
+    VLRope Split(const size_t pos){
+        if (pos > Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        VLRope ret;
+        Split(root_, pos, root_, ret.root_);
+        return ret;
+    }
+
+    /**
+     * moves all of rhs to the end of this rope, O(log n). rhs is left empty.
+     * @param rhs
+     */
+    void Concat(VLRope &rhs){
+        if (this == &rhs) {return;}
+        root_ = Merge(root_, rhs.root_);
+        rhs.root_ = nullptr;
+    }
+
+    /**
+     * calls func(VLStringView) on every chunk in order, e.g. to fill an iovec for writev.
+     * @tparam Func
+     * @param func
+     */
+    template<class Func>
+    void ForEachChunk(Func func) const{
+        VLVector<const Node*> stack;
+        const Node *node = root_;
+        while (node || !stack.Empty()){
+            while (node){
+                stack.PushBack(node);
+                node = node->left;
+            }
+            node = stack[stack.Size() - 1];
+            stack.PopBack();
+            func(node->text.View());
+            node = node->right;
+        }
+    }
+
+    /**
+     * @return number of chunks
+     */
+    size_t ChunkCount() const{
+        size_t ret = 0;
+        ForEachChunk([&ret](const VLStringView) { ret++; });
+        return ret;
+    }
+
+    /**
+     * flattens the rope with one growth and one copy per chunk.
+     * @return the whole text
+     */
+    VLString<> ToVLString() const{
+        VLString<> ret;
+        char *dest = ret.Grow(Size());
+        ForEachChunk([&dest](const VLStringView chunk) {
+            memcpy(dest, chunk.Data(), chunk.Size());
+            dest += chunk.Size();
+        });
+        return ret;
+    }
+};
+
+#endif // VL_ROPE_H_
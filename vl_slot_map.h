@@ -0,0 +1,156 @@
+#ifndef VL_SLOT_MAP_H_
+#define VL_SLOT_MAP_H_
+
+#include "vl_span.h"
+
+#define SLOT_NONE 0xffffffffu
+#define SLOT_NULL_HANDLE 0ULL
+
+
+/**
+ * an object store that hands out 64 bit handles: generation << 32 | slot.
+ * the values are kept packed in one VLVector, so iterating over the live objects is a
+ * plain loop over Values(). a slot table maps every handle to its value's current index.
+ * erasing moves the last value into the hole (swap-remove) and bumps the slot's generation,
+ * so Insert, Erase and Get are O(1) and a stale handle is detected instead of reaching
+ * whatever reused its slot. generations start at 1, so SLOT_NULL_HANDLE is never valid.
+ * @tparam T
+ * @tparam StaticCapacity
+ */
+template<class T, size_t StaticCapacity = START_CAP>
+class VLSlotMap{
+
+    public:
+    typedef uint64_t Handle;
+
+    private:
+    struct Slot{
+        uint32_t index; // into values_ while live, the next free slot while free
+        uint32_t generation;
+    };
+
+    VLVector<T, StaticCapacity> values_;
+    VLVector<uint32_t, StaticCapacity> value_slots_; // slot of every value, for the swap-remove
+    VLVector<Slot, StaticCapacity> slots_;
+    uint32_t free_head_;
+
+    static Handle MakeHandle(const uint32_t slot, const uint32_t generation) noexcept{
+        return ((Handle) generation << 32) | slot;
+    }
+
+    /**
+     * @return the slot of handle, or SLOT_NONE if the handle is stale or was never given
+     */
+    uint32_t SlotOf(const Handle handle) const noexcept{
+        uint32_t slot = (uint32_t) handle;
+        if (slot >= slots_.Size() || slots_.Data()[slot].generation != (uint32_t) (handle >> 32)){
+            return SLOT_NONE;
+        }
+        return slot;
+    }
+
+    public:
+
+    VLSlotMap(): free_head_(SLOT_NONE) {}
+
+    size_t Size() const noexcept{
+        return values_.Size();
+    }
+
+    bool Empty() const noexcept{
+        return values_.Empty();
+    }
+
+    /**
+     * stores value, reusing a free slot if there is one.
+     * @return its handle
+     */
+    Handle Insert(const T &value){
+        uint32_t slot;
+        if (free_head_ != SLOT_NONE){
+            slot = free_head_;
+            free_head_ = slots_[slot].index;
+        } else {
+            Slot fresh;
+            fresh.generation = 1;
+            slots_.PushBack(fresh);
+            slot = (uint32_t) slots_.Size() - 1;
+        }
+        slots_[slot].index = (uint32_t) values_.Size();
+        values_.PushBack(value);
+        value_slots_.PushBack(slot);
+        return MakeHandle(slot, slots_[slot].generation);
+    }
+
+    /**
+     * @return the value of handle, nullptr if it was erased. valid until the next Insert / Erase.
+     */
+    T* Get(const Handle handle) noexcept{
+        uint32_t slot = SlotOf(handle);
+        return slot == SLOT_NONE ? nullptr : values_.Data() + slots_[slot].index;
+    }
+
+    const T* Get(const Handle handle) const noexcept{
+        uint32_t slot = SlotOf(handle);
+        return slot == SLOT_NONE ? nullptr : values_.Data() + slots_.Data()[slot].index;
+    }
+
+    bool Contains(const Handle handle) const noexcept{
+        return SlotOf(handle) != SLOT_NONE;
+    }
+
+    /**
+     * removes the value of handle by moving the last value into its place.
+     * @return false if handle was already erased
+     */
+    bool Erase(const Handle handle){
+        uint32_t slot = SlotOf(handle);
+        if (slot == SLOT_NONE){
+            return false;
+        }
+        uint32_t index = slots_[slot].index;
+        uint32_t last = (uint32_t) values_.Size() - 1;
+        if (index != last){
+            values_[index] = std::move(values_[last]);
+            value_slots_[index] = value_slots_[last];
+            slots_[value_slots_[index]].index = index;
+        }
+        values_.PopBack();
+        value_slots_.PopBack();
+        slots_[slot].generation++;
+        slots_[slot].index = free_head_;
+        free_head_ = slot;
+        return true;
+    }
+
+    /**
+     * the live values, packed, in no particular order.
+     */
+    VLSpan<T> Values() noexcept{
+        return VLSpan<T>(values_.Data(), values_.Size());
+    }
+
+    VLSpan<const T> Values() const noexcept{
+        return VLSpan<const T>(values_.Data(), values_.Size());
+    }
+
+    /**
+     * @param index into Values()
+     * @return the handle of that value
+     */
+    Handle HandleAt(const size_t index) const noexcept{
+        uint32_t slot = value_slots_.Data()[index];
+        return MakeHandle(slot, slots_.Data()[slot].generation);
+    }
+
+    /**
+     * erases every value, every handle given so far becomes stale.
+     */
+    void Clear(){
+        while (!values_.Empty()){
+            Erase(HandleAt(values_.Size() - 1));
+        }
+    }
+};
+
+#endif // VL_SLOT_MAP_H_
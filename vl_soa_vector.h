@@ -0,0 +1,151 @@
+#ifndef VL_SOA_VECTOR_H_
+#define VL_SOA_VECTOR_H_
+
+#include <tuple>
+#include <utility>
+#include "vl_span.h"
+
+
+/**
+ * records of Fields... stored as a structure of arrays: one VLVector per field, all of
+ * the same size. a scan of one field reads only that field's column, and Column<I>()
+ * hands it out as a contiguous span for tight (vectorizable) loops.
+ * every column keeps the first StaticCapacity items inline and grows the way VLVector does,
+ * so the columns always spill together.
+ * @tparam StaticCapacity
+ * @tparam Fields
+ */
+template<size_t StaticCapacity, class... Fields>
+class VLSoAVector{
+
+    static_assert(sizeof...(Fields) > 0, "VLSoAVector needs at least one field");
+
+    public:
+    typedef std::tuple<Fields...> Row;
+
+    template<size_t I>
+    using Field = typename std::tuple_element<I, Row>::type;
+
+    private:
+    typedef std::index_sequence_for<Fields...> Indexes;
+
+    std::tuple<VLVector<Fields, StaticCapacity>...> columns_;
+
+    /**
+     * calls func on every column in order. the array only forces the pack expansion.
+     */
+    template<class Func, size_t... I>
+    void ForEachColumn(Func func, std::index_sequence<I...>){
+        int expand[] = {0, (func(std::get<I>(columns_)), 0)...};
+        (void) expand;
+    }
+
+    template<size_t... I>
+    void PushRow(const Row &row, std::index_sequence<I...>){
+        int expand[] = {0, (std::get<I>(columns_).PushBack(std::get<I>(row)), 0)...};
+        (void) expand;
+    }
+
+    template<size_t... I>
+    Row GetRow(const size_t index, std::index_sequence<I...>) const{
+        return Row(std::get<I>(columns_).Data()[index]...);
+    }
+
+    template<size_t... I>
+    void SetRow(const size_t index, const Row &row, std::index_sequence<I...>){
+        int expand[] = {0, (std::get<I>(columns_).Data()[index] = std::get<I>(row), 0)...};
+        (void) expand;
+    }
+
+    struct PopColumn{
+        template<class Column>
+        void operator()(Column &column) const{
+            column.PopBack();
+        }
+    };
+
+    struct ClearColumn{
+        template<class Column>
+        void operator()(Column &column) const{
+            column.Clear();
+        }
+    };
+
+    public:
+
+    size_t Size() const noexcept{
+        return std::get<0>(columns_).Size();
+    }
+
+    bool Empty() const noexcept{
+        return Size() == 0;
+    }
+
+    size_t Capacity() const noexcept{
+        return std::get<0>(columns_).Capacity();
+    }
+
+    /**
+     * appends one record, a value to each column.
+     */
+    void PushBack(const Row &row){
+        PushRow(row, Indexes());
+    }
+
+    void PushBack(const Fields&... values){
+        PushRow(Row(values...), Indexes());
+    }
+
+    void PopBack(){
+        ForEachColumn(PopColumn(), Indexes());
+    }
+
+    void Clear(){
+        ForEachColumn(ClearColumn(), Indexes());
+    }
+
+    /**
+     * @return the whole column of field I, valid until the size changes
+     */
+    template<size_t I>
+    VLSpan<Field<I>> Column() noexcept{
+        return VLSpan<Field<I>>(std::get<I>(columns_).Data(), Size());
+    }
+
+    template<size_t I>
+    VLSpan<const Field<I>> Column() const noexcept{
+        return VLSpan<const Field<I>>(std::get<I>(columns_).Data(), Size());
+    }
+
+    /**
+     * @return field I of record index
+     */
+    template<size_t I>
+    Field<I>& Get(const size_t index) noexcept{
+        return std::get<I>(columns_).Data()[index];
+    }
+
+    template<size_t I>
+    const Field<I>& Get(const size_t index) const noexcept{
+        return std::get<I>(columns_).Data()[index];
+    }
+
+    /**
+     * gathers record index from every column.
+     */
+    Row At(const size_t index) const{
+        if (index >= Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        return GetRow(index, Indexes());
+    }
+
+    void Set(const size_t index, const Row &row){
+        if (index >= Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        SetRow(index, row, Indexes());
+    }
+};
+
+#endif // VL_SOA_VECTOR_H_
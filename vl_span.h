@@ -0,0 +1,83 @@
+#ifndef VL_SPAN_H_
+#define VL_SPAN_H_
+
+#ifndef START_CAP
+#include "vl_vector.h"
+#endif
+
+
+/**
+ * a non owning view of size items stored one after the other.
+ * it is two words and is passed by value, like VLStringView.
+ * the items must outlive the span, and any change to a VLVector's size may move them.
+ * @tparam T const T for a read only span
+ */
+template<class T>
+class VLSpan{
+
+    T *data_;
+    size_t size_;
+
+    public:
+
+    VLSpan(): data_(nullptr), size_(0) {}
+
+    VLSpan(T *data, const size_t size): data_(data), size_(size) {}
+
+    template<class U, size_t StaticCapacity>
+    VLSpan(const VLVector<U, StaticCapacity> &vec): data_(vec.Data()), size_(vec.Size()) {}
+
+    /**
+     * a span of T converts to a span of const T.
+     */
+    template<class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    VLSpan(const VLSpan<U> &rhs): data_(rhs.Data()), size_(rhs.Size()) {}
+
+    T* Data() const noexcept{
+        return data_;
+    }
+
+    size_t Size() const noexcept{
+        return size_;
+    }
+
+    bool Empty() const noexcept{
+        return size_ == 0;
+    }
+
+    T& operator[](const size_t index) const noexcept{
+        return data_[index];
+    }
+
+    T& At(const size_t index) const{
+        if (index >= size_){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        return data_[index];
+    }
+
+    /**
+     * @param offset at most Size()
+     * @param count cut to what is left after offset
+     * @return the items [offset, offset + count)
+     */
+    VLSpan Subspan(const size_t offset, size_t count) const{
+        if (offset > size_){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        if (count > size_ - offset){
+            count = size_ - offset;
+        }
+        return VLSpan(data_ + offset, count);
+    }
+
+    T* begin() const noexcept{
+        return data_;
+    }
+
+    T* end() const noexcept{
+        return data_ + size_;
+    }
+};
+
+#endif // VL_SPAN_H_
@@ -0,0 +1,104 @@
+#ifndef VL_SPARSE_SET_H_
+#define VL_SPARSE_SET_H_
+
+#include "vl_span.h"
+
+
+/**
+ * a set of small integer ids: a dense list of the members and a sparse array, indexed
+ * by id, holding each member's place in the dense list.
+ * an id is a member iff its sparse entry points below Size() at a dense slot holding that id,
+ * so stale entries never need cleaning: Clear() just resets the count and touches no memory.
+ * Insert, Erase and Contains are O(1). the dense list keeps insertion order until an Erase,
+ * which moves the last member into the gap.
+ * the sparse array grows (zero filled) to the largest id inserted.
+ * @tparam StaticCapacity
+ */
+template<size_t StaticCapacity = START_CAP>
+class VLSparseSet{
+
+    VLVector<uint32_t, StaticCapacity> dense_;  // members in [0, count_), leftovers after
+    VLVector<uint32_t, StaticCapacity> sparse_; // id -> index into dense_, may be stale
+    size_t count_;
+
+    public:
+
+    VLSparseSet(): count_(0) {}
+
+    size_t Size() const noexcept{
+        return count_;
+    }
+
+    bool Empty() const noexcept{
+        return count_ == 0;
+    }
+
+    bool Contains(const uint32_t id) const noexcept{
+        if (id >= sparse_.Size()){
+            return false;
+        }
+        uint32_t index = sparse_.Data()[id];
+        return index < count_ && dense_.Data()[index] == id;
+    }
+
+    /**
+     * @return false if id was already a member
+     */
+    bool Insert(const uint32_t id){
+        if (Contains(id)){
+            return false;
+        }
+        if (id >= sparse_.Size()){
+            size_t added = (size_t) id + 1 - sparse_.Size();
+            uint32_t *fresh = sparse_.Grow(added);
+            memset(fresh, 0, added * sizeof(uint32_t));
+        }
+        if (count_ < dense_.Size()){
+            dense_[count_] = id; // reuse a slot left by Clear / Erase
+        } else {
+            dense_.PushBack(id);
+        }
+        sparse_[id] = (uint32_t) count_;
+        count_++;
+        return true;
+    }
+
+    /**
+     * @return false if id was not a member
+     */
+    bool Erase(const uint32_t id) noexcept{
+        if (!Contains(id)){
+            return false;
+        }
+        uint32_t index = sparse_[id];
+        uint32_t last = dense_[count_ - 1];
+        dense_[index] = last;
+        sparse_[last] = index;
+        count_--;
+        return true;
+    }
+
+    /**
+     * forgets every member in O(1), the memory is kept for the next inserts.
+     */
+    void Clear() noexcept{
+        count_ = 0;
+    }
+
+    /**
+     * the members, in insertion order unless something was erased.
+     */
+    VLSpan<const uint32_t> Members() const noexcept{
+        return VLSpan<const uint32_t>(dense_.Data(), count_);
+    }
+
+    const uint32_t* begin() const noexcept{
+        return dense_.Data();
+    }
+
+    const uint32_t* end() const noexcept{
+        return dense_.Data() + count_;
+    }
+};
+
+#endif // VL_SPARSE_SET_H_
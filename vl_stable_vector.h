@@ -0,0 +1,193 @@
+#ifndef VL_STABLE_VECTOR_H_
+#define VL_STABLE_VECTOR_H_
+
+#include "vl_span.h"
+
+#define STABLE_SEGMENT_SIZE 1024
+
+
+/**
+ * a vector that never moves its items.
+ * the first InlineCapacity items live inside the object, the rest in heap segments of
+ * SegmentSize items. growing adds a segment and copies nothing, so pointers and references
+ * stay valid until their item is popped, and no push pays for copying the whole vector.
+ * item index is found with a shift and a mask, and Segment(k) / ForEachSegment give
+ * contiguous runs for loops the compiler can vectorize.
+ * @tparam T
+ * @tparam InlineCapacity
+ * @tparam SegmentSize a power of two
+ */
+template<class T, size_t InlineCapacity = START_CAP, size_t SegmentSize = STABLE_SEGMENT_SIZE>
+class VLStableVector{
+
+    static_assert(SegmentSize > 0 && (SegmentSize & (SegmentSize - 1)) == 0,
+                  "VLStableVector needs a power of two SegmentSize");
+
+    static const size_t SEGMENT_MASK = SegmentSize - 1;
+
+    T static_data_[InlineCapacity > 0 ? InlineCapacity : 1];
+    VLVector<T*> segments_; // heap segments, the ones past the size are kept for reuse
+    size_t size_;
+
+    static constexpr size_t SegmentShift() noexcept{
+        size_t shift = 0;
+        while (((size_t) 1 << shift) < SegmentSize){
+            shift++;
+        }
+        return shift;
+    }
+
+    T* Slot(const size_t index) const noexcept{
+        if (index < InlineCapacity){
+            return const_cast<T*>(static_data_) + index;
+        }
+        size_t heap_index = index - InlineCapacity;
+        return segments_.Data()[heap_index >> SegmentShift()] + (heap_index & SEGMENT_MASK);
+    }
+
+    /**
+     * @return heap segments holding at least one item
+     */
+    size_t UsedSegments() const noexcept{
+        return size_ <= InlineCapacity ? 0 : (size_ - InlineCapacity + SEGMENT_MASK) / SegmentSize;
+    }
+
+    void FreeSegments(const size_t keep) noexcept{
+        while (segments_.Size() > keep){
+            delete[] segments_[segments_.Size() - 1];
+            segments_.PopBack();
+        }
+    }
+
+    public:
+
+    VLStableVector(): size_(0) {}
+
+    VLStableVector(const VLStableVector &rhs): size_(0) {
+        for (size_t ix = 0 ; ix < rhs.size_ ; ix++){
+            PushBack(rhs[ix]);
+        }
+    }
+
+    VLStableVector &operator=(const VLStableVector &rhs){
+        if (this != &rhs){
+            Clear();
+            for (size_t ix = 0 ; ix < rhs.size_ ; ix++){
+                PushBack(rhs[ix]);
+            }
+        }
+        return *this;
+    }
+
+    ~VLStableVector(){
+        FreeSegments(0);
+    }
+
+    size_t Size() const noexcept{
+        return size_;
+    }
+
+    bool Empty() const noexcept{
+        return size_ == 0;
+    }
+
+    /**
+     * @return items that fit without allocating
+     */
+    size_t Capacity() const noexcept{
+        return InlineCapacity + segments_.Size() * SegmentSize;
+    }
+
+    /**
+     * adds value at the end, allocating one segment at most. nothing already stored moves.
+     * @return the new item, its address is stable
+     */
+    T& PushBack(const T &value){
+        if (size_ == Capacity()){
+            segments_.PushBack(new T[SegmentSize]);
+        }
+        T *slot = Slot(size_);
+        *slot = value;
+        size_++;
+        return *slot;
+    }
+
+    /**
+     * removes the last item, does nothing if empty. its segment is kept for the next pushes.
+     */
+    void PopBack() noexcept{
+        if (size_ == 0) {return;}
+        size_--;
+    }
+
+    T& operator[](const size_t index) noexcept{
+        return *Slot(index);
+    }
+
+    const T& operator[](const size_t index) const noexcept{
+        return *Slot(index);
+    }
+
+    T& At(const size_t index){
+        if (index >= size_){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        return *Slot(index);
+    }
+
+    T& Back() noexcept{
+        return *Slot(size_ - 1);
+    }
+
+    /**
+     * @return number of contiguous runs, the inline one included
+     */
+    size_t SegmentCount() const noexcept{
+        return (size_ > 0 && InlineCapacity > 0) + UsedSegments();
+    }
+
+    /**
+     * @param segment below SegmentCount()
+     * @return the items of that run: the inline items first, then each heap segment
+     */
+    VLSpan<T> Segment(size_t segment) noexcept{
+        if (InlineCapacity > 0){
+            if (segment == 0){
+                return VLSpan<T>(static_data_, size_ < InlineCapacity ? size_ : InlineCapacity);
+            }
+            segment--;
+        }
+        size_t first = InlineCapacity + segment * SegmentSize;
+        size_t len = size_ - first < SegmentSize ? size_ - first : SegmentSize;
+        return VLSpan<T>(segments_[segment], len);
+    }
+
+    /**
+     * calls func(VLSpan<T>) on every contiguous run in order.
+     * @tparam Func
+     * @param func
+     */
+    template<class Func>
+    void ForEachSegment(Func func){
+        for (size_t ix = 0 ; ix < SegmentCount() ; ix++){
+            func(Segment(ix));
+        }
+    }
+
+    /**
+     * empties the vector and frees every segment.
+     */
+    void Clear() noexcept{
+        FreeSegments(0);
+        size_ = 0;
+    }
+
+    /**
+     * frees the segments past the last item.
+     */
+    void ShrinkToFit() noexcept{
+        FreeSegments(UsedSegments());
+    }
+};
+
+#endif // VL_STABLE_VECTOR_H_
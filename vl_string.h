@@ -1,14 +1,832 @@
+#ifndef VL_STRING_H_
+#define VL_STRING_H_
+
 #ifndef START_CAP
 #include "vl_vector.h"
 #endif
+#include <cstring>
+#include "vl_swar.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <cctype>
+#include <stdexcept>
+#include <atomic>
+#include <string>
 
-template <size_t StaticCapacity = START_CAP>
-class VLString : public VLVector<char,StaticCapacity>{
+#define DOUBLE_BUF_LEN 32
+#define FORMAT_SEGMENTS 16
+#define BAD_FORMAT "bad format string.\n"
+#define NOT_FOUND ((size_t) -1)
+#define CHAR_ONLY "only available for char strings"
+
+#define UTF8_REPLACEMENT 0xfffd
+#define HEX_DIGITS "0123456789abcdef"
+#define BASE64_ALPHABET "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+#define CODEC_INVALID 0xff
+#define BASE64_PAD 0xfe
+#define BASE64_SPACE 0xfd
+
+/**
+ * checks one utf-8 sequence (no overlong forms, no surrogates, nothing above U+10FFFF).
+ * @param it first byte, a non ascii one
+ * @param end
+ * @return length of the sequence, or 0 if it is invalid or cut by end
+ */
+inline size_t VLUtf8SequenceLength(const unsigned char *it, const unsigned char *end) noexcept{
+    unsigned char lead = *it;
+    size_t len;
+    unsigned char second_lo = 0x80, second_hi = 0xbf;
+    if (lead >= 0xc2 && lead <= 0xdf){
+        len = 2;
+    } else if (lead >= 0xe0 && lead <= 0xef){
+        len = 3;
+        if (lead == 0xe0) {second_lo = 0xa0;} // overlong
+        if (lead == 0xed) {second_hi = 0x9f;} // surrogates
+    } else if (lead >= 0xf0 && lead <= 0xf4){
+        len = 4;
+        if (lead == 0xf0) {second_lo = 0x90;} // overlong
+        if (lead == 0xf4) {second_hi = 0x8f;} // above U+10FFFF
+    } else {
+        return 0;
+    }
+    if ((size_t) (end - it) < len || it[1] < second_lo || it[1] > second_hi){
+        return 0;
+    }
+    for (size_t ix = 2 ; ix < len ; ix++){
+        if ((it[ix] & 0xc0) != 0x80){
+            return 0;
+        }
+    }
+    return len;
+}
+
+/**
+ * walks utf-8 text one code point at a time.
+ * an invalid byte reads as U+FFFD and is skipped on its own.
+ */
+class VLCodePointIterator{
+
+    const unsigned char *it_;
+    const unsigned char *end_;
+    char32_t code_point_;
+    size_t len_;
+
+    void Decode() noexcept{
+        if (it_ == end_){
+            len_ = 0;
+            return;
+        }
+        if (*it_ < 0x80){
+            code_point_ = *it_;
+            len_ = 1;
+            return;
+        }
+        len_ = VLUtf8SequenceLength(it_, end_);
+        if (len_ == 0){
+            code_point_ = UTF8_REPLACEMENT;
+            len_ = 1;
+            return;
+        }
+        code_point_ = it_[0] & (0x7f >> len_);
+        for (size_t ix = 1 ; ix < len_ ; ix++){
+            code_point_ = (code_point_ << 6) | (it_[ix] & 0x3f);
+        }
+    }
+
+    public:
+
+    VLCodePointIterator(const char *it, const char *end):
+        it_((const unsigned char*) it), end_((const unsigned char*) end), code_point_(0), len_(0) {
+        Decode();
+    }
+
+    char32_t operator*() const noexcept{
+        return code_point_;
+    }
+
+    VLCodePointIterator &operator++() noexcept{
+        it_ += len_;
+        Decode();
+        return *this;
+    }
+
+    bool operator==(const VLCodePointIterator &rhs) const noexcept{
+        return it_ == rhs.it_;
+    }
+
+    bool operator!=(const VLCodePointIterator &rhs) const noexcept{
+        return it_ != rhs.it_;
+    }
+};
+
+/**
+ * the begin / end pair returned by CodePoints(), for range based for loops.
+ */
+class VLCodePointRange{
+
+    const char *begin_;
+    const char *end_;
+
+    public:
+
+    VLCodePointRange(const char *begin, const char *end): begin_(begin), end_(end) {}
+
+    VLCodePointIterator begin() const noexcept{
+        return VLCodePointIterator(begin_, end_);
+    }
+
+    VLCodePointIterator end() const noexcept{
+        return VLCodePointIterator(end_, end_);
+    }
+};
+
+/**
+ * a non owning (pointer, length) view over characters.
+ * it does not have to be \0 terminated.
+ * the ascii and utf-8 members only exist for char views.
+ */
+template <class CharT>
+class VLBasicStringView{
+
+    typedef std::char_traits<CharT> Traits;
+
+    const CharT *data_;
+    size_t size_;
+
+    public:
+
+    VLBasicStringView(): data_(EmptyString()), size_(0) {}
+
+    VLBasicStringView(const CharT *data, const size_t size): data_(data), size_(size) {}
+
+    /**
+     * implicit CTOR from a \0 terminated string.
+     * @param string
+     */
+    VLBasicStringView(const CharT *string): data_(string), size_(Traits::length(string)) {}
+
+    static const CharT* EmptyString() noexcept{
+        static const CharT empty[1] = {};
+        return empty;
+    }
+
+    const CharT* Data() const noexcept{
+        return data_;
+    }
+
+    size_t Size() const noexcept{
+        return size_;
+    }
+
+    bool Empty() const noexcept{
+        return size_ == 0;
+    }
+
+    CharT operator[](const size_t index) const noexcept{
+        return data_[index];
+    }
+
+    const CharT* begin() const noexcept{
+        return data_;
+    }
+
+    const CharT* end() const noexcept{
+        return data_ + size_;
+    }
+
+    /**
+     * orders by bytes (as unsigned char) and then by length, like std::string.
+     * @param rhs
+     * @return negative, zero or positive
+     */
+    int Compare(const VLBasicStringView &rhs) const noexcept{
+        size_t common = size_ < rhs.size_ ? size_ : rhs.size_;
+        int ret = Traits::compare(data_, rhs.data_, common); // memcmp for char
+        if (ret != 0){
+            return ret;
+        }
+        return size_ < rhs.size_ ? -1 : (size_ > rhs.size_ ? 1 : 0);
+    }
+
+    /**
+     * char_traits::find (memchr for char) finds the candidates for the first char,
+     * memcmp checks the rest.
+     * @param needle
+     * @param from where to start looking
+     * @return position of the first match at or after from, or NOT_FOUND
+     */
+    size_t Find(const VLBasicStringView &needle, const size_t from = 0) const noexcept{
+        if (from > size_ || needle.size_ > size_ - from){
+            return NOT_FOUND;
+        }
+        if (needle.size_ == 0){
+            return from;
+        }
+        const CharT *it = data_ + from;
+        const CharT *last = data_ + size_ - needle.size_; // last place a match can start
+        while (it <= last){
+            it = Traits::find(it, last - it + 1, needle.data_[0]);
+            if (!it){
+                return NOT_FOUND;
+            }
+            if (memcmp(it + 1, needle.data_ + 1, (needle.size_ - 1) * sizeof(CharT)) == 0){
+                return it - data_;
+            }
+            it++;
+        }
+        return NOT_FOUND;
+    }
+
+    bool StartsWith(const VLBasicStringView &prefix) const noexcept{
+        return prefix.size_ <= size_ && memcmp(data_, prefix.data_, prefix.size_ * sizeof(CharT)) == 0;
+    }
+
+    bool EndsWith(const VLBasicStringView &suffix) const noexcept{
+        return suffix.size_ <= size_
+               && memcmp(data_ + size_ - suffix.size_, suffix.data_, suffix.size_ * sizeof(CharT)) == 0;
+    }
+
+    /**
+     * @return this view without leading ascii white space
+     */
+    VLBasicStringView TrimLeft() const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        const char *it = data_;
+        const char *end = data_ + size_;
+        for (; end - it >= 8 ; it += 8){
+            uint64_t not_space = ~SwarSpaceBytes(SwarLoad(it)) & SWAR_HIGHS;
+            if (not_space){
+                return VLBasicStringView(it + SwarFirstByte(not_space), end - it - SwarFirstByte(not_space));
+            }
+        }
+        while (it != end && isspace((unsigned char) *it)){
+            it++;
+        }
+        return VLBasicStringView(it, end - it);
+    }
+
+    /**
+     * @return this view without trailing ascii white space
+     */
+    VLBasicStringView TrimRight() const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        const char *end = data_ + size_;
+        for (; end - data_ >= 8 ; end -= 8){
+            uint64_t not_space = ~SwarSpaceBytes(SwarLoad(end - 8)) & SWAR_HIGHS;
+            if (not_space){
+                return VLBasicStringView(data_, end - 8 + SwarLastByte(not_space) + 1 - data_);
+            }
+        }
+        while (end != data_ && isspace((unsigned char) end[-1])){
+            end--;
+        }
+        return VLBasicStringView(data_, end - data_);
+    }
+
+    VLBasicStringView TrimBoth() const noexcept{
+        return TrimLeft().TrimRight();
+    }
+
+    /**
+     * compares 8 chars at a time after folding ascii letters to lower case.
+     * @param rhs
+     * @return true if equal ignoring ascii case
+     */
+    bool EqualsIgnoreCaseAscii(const VLBasicStringView &rhs) const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        if (size_ != rhs.size_) {return false;}
+        size_t ix = 0;
+        for (; ix + 8 <= size_ ; ix += 8){
+            if (SwarToLowerAscii(SwarLoad(data_ + ix)) != SwarToLowerAscii(SwarLoad(rhs.data_ + ix))){
+                return false;
+            }
+        }
+        for (; ix < size_ ; ix++){
+            if (tolower((unsigned char) data_[ix]) != tolower((unsigned char) rhs.data_[ix])){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * ascii runs are skipped 16 bytes at a time, only the multi byte sequences
+     * are checked one by one.
+     * @return true if the view is well formed utf-8
+     */
+    bool IsValidUtf8() const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        const unsigned char *it = (const unsigned char*) data_;
+        const unsigned char *end = it + size_;
+        while (it != end){
+            if (end - it >= 16 && ((SwarLoad(it) | SwarLoad(it + 8)) & SWAR_HIGHS) == 0){
+                it += 16;
+                continue;
+            }
+            if (*it < 0x80){
+                it++;
+                continue;
+            }
+            size_t len = VLUtf8SequenceLength(it, end);
+            if (len == 0){
+                return false;
+            }
+            it += len;
+        }
+        return true;
+    }
+
+    /**
+     * counts the bytes that do not continue a sequence (are not 10xxxxxx), 8 at a time.
+     * assumes valid utf-8, see IsValidUtf8.
+     * @return number of code points
+     */
+    size_t CodePointCount() const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        size_t ret = 0;
+        size_t ix = 0;
+        for (; ix + 8 <= size_ ; ix += 8){
+            uint64_t word = SwarLoad(data_ + ix);
+            if ((word & SWAR_HIGHS) == 0){
+                ret += 8;
+                continue;
+            }
+            uint64_t continuations = word & ~(word << 1) & SWAR_HIGHS; // bit 7 set, bit 6 clear
+            ret += 8 - VLPopCount64(continuations);
+        }
+        for (; ix < size_ ; ix++){
+            ret += ((unsigned char) data_[ix] & 0xc0) != 0x80;
+        }
+        return ret;
+    }
+
+    VLCodePointRange CodePoints() const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        return VLCodePointRange(data_, data_ + size_);
+    }
+
+    /**
+     * @return same hash a VLBasicString with these characters has.
+     */
+    size_t Hash() const noexcept {
+        return VLHashBytes(data_, size_ * sizeof(CharT));
+    }
+};
+
+typedef VLBasicStringView<char> VLStringView;
+typedef VLBasicStringView<char16_t> VLU16StringView;
+typedef VLBasicStringView<char32_t> VLU32StringView;
+
+/**
+ * comparison operators are free functions so that either side may be a view,
+ * a \0 terminated string or a VLBasicString, without building a temporary string.
+ * they are not templates (template deduction would skip those conversions),
+ * so they are stamped out once per view type.
+ */
+#define VL_STRING_VIEW_OPERATORS(ViewType) \
+    inline bool operator==(const ViewType &lhs, const ViewType &rhs) noexcept{ \
+        return lhs.Size() == rhs.Size() && memcmp(lhs.Data(), rhs.Data(), lhs.Size() * sizeof(*lhs.Data())) == 0; \
+    } \
+    inline bool operator!=(const ViewType &lhs, const ViewType &rhs) noexcept{ \
+        return !(lhs == rhs); \
+    } \
+    inline bool operator<(const ViewType &lhs, const ViewType &rhs) noexcept{ \
+        return lhs.Compare(rhs) < 0; \
+    } \
+    inline bool operator<=(const ViewType &lhs, const ViewType &rhs) noexcept{ \
+        return lhs.Compare(rhs) <= 0; \
+    } \
+    inline bool operator>(const ViewType &lhs, const ViewType &rhs) noexcept{ \
+        return lhs.Compare(rhs) > 0; \
+    } \
+    inline bool operator>=(const ViewType &lhs, const ViewType &rhs) noexcept{ \
+        return lhs.Compare(rhs) >= 0; \
+    }
+
+VL_STRING_VIEW_OPERATORS(VLStringView)
+VL_STRING_VIEW_OPERATORS(VLU16StringView)
+VL_STRING_VIEW_OPERATORS(VLU32StringView)
 
+/**
+ * one argument of VLString::Format, with its type erased
+ * so the formatting loop is not instantiated for every argument list.
+ */
+struct VLFormatArg{
+
+    enum Kind {SIGNED, UNSIGNED, DOUBLE, CHAR, BOOL, STRING};
+
+    Kind kind;
+    long long signed_value;
+    unsigned long long unsigned_value;
+    double double_value;
+    VLStringView string_value;
+
+    VLFormatArg(): kind(STRING), signed_value(0), unsigned_value(0), double_value(0) {}
+
+    template<class T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+    VLFormatArg(const T value): VLFormatArg() {
+        kind = SIGNED;
+        signed_value = value;
+    }
+
+    template<class T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, int>::type = 0>
+    VLFormatArg(const T value): VLFormatArg() {
+        kind = UNSIGNED;
+        unsigned_value = value;
+    }
+
+    VLFormatArg(const double value): VLFormatArg() {
+        kind = DOUBLE;
+        double_value = value;
+    }
+
+    VLFormatArg(const char value): VLFormatArg() {
+        kind = CHAR;
+        signed_value = value;
+    }
+
+    VLFormatArg(const bool value): VLFormatArg() {
+        kind = BOOL;
+        signed_value = value;
+    }
+
+    VLFormatArg(const char *value): VLFormatArg() {
+        string_value = VLStringView(value);
+    }
+
+    VLFormatArg(const VLStringView value): VLFormatArg() {
+        string_value = value;
+    }
+};
+
+/**
+ * a VLVector of characters that keeps a \0 after the last one.
+ * use it through the VLBasicString, VLU16String and VLU32String aliases below.
+ * the number formatting, Format, ascii and utf-8 members only exist for char.
+ */
+template <class CharT, size_t StaticCapacity = START_CAP>
+class VLBasicString : public VLVector<CharT,StaticCapacity>{
+
+    typedef VLBasicStringView<CharT> ViewType;
+
+    /**
+     * @return number of decimal digits in value
+     */
+    static size_t CountDigits(unsigned long long value) noexcept{
+        size_t ret = 1;
+        while (value >= 10000){
+            value /= 10000;
+            ret += 4;
+        }
+        return ret + (value >= 10) + (value >= 100) + (value >= 1000);
+    }
+
+    /**
+     * writes value backwards, two digits per step, ending just before end.
+     */
+    static void WriteDigits(char *end, unsigned long long value) noexcept{
+        static const char pairs[] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+        while (value >= 100){
+            size_t pair = (size_t) (value % 100) * 2;
+            value /= 100;
+            *--end = pairs[pair + 1];
+            *--end = pairs[pair];
+        }
+        if (value >= 10){
+            *--end = pairs[value * 2 + 1];
+            *--end = pairs[value * 2];
+        } else {
+            *--end = (char) ('0' + value);
+        }
+    }
+
+
+    /**
+     * @return mask of the bytes of word a JSON string has to escape
+     */
+    static uint64_t JsonSpecialBytes(const uint64_t word) noexcept{
+        return SwarLessBytes(word, 0x20) | SwarEqualBytes(word, '"') | SwarEqualBytes(word, '\\');
+    }
+
+    /**
+     * @return how many bytes escaping c adds
+     */
+    static size_t JsonEscapeExtra(const char c) noexcept{
+        switch (c){
+            case '"': case '\\': case '\b': case '\f': case '\n': case '\r': case '\t':
+                return 1;
+            default:
+                return (unsigned char) c < 0x20 ? 5 : 0; // \u00XX
+        }
+    }
+
+    static char* WriteJsonEscape(char *dest, const unsigned char c) noexcept{
+        *dest++ = '\\';
+        switch (c){
+            case '"': *dest++ = '"'; break;
+            case '\\': *dest++ = '\\'; break;
+            case '\b': *dest++ = 'b'; break;
+            case '\f': *dest++ = 'f'; break;
+            case '\n': *dest++ = 'n'; break;
+            case '\r': *dest++ = 'r'; break;
+            case '\t': *dest++ = 't'; break;
+            default:
+                memcpy(dest, "u00", 3);
+                dest[3] = "0123456789abcdef"[c >> 4];
+                dest[4] = "0123456789abcdef"[c & 0xf];
+                dest += 5;
+        }
+        return dest;
+    }
+
+    /**
+     * reads 4 hex digits and advances it past them.
+     * @return false if there are not 4 hex digits
+     */
+    static bool ReadHex4(const char *&it, const char *end, uint32_t &out) noexcept{
+        if (end - it < 4) {return false;}
+        out = 0;
+        for (int ix = 0 ; ix < 4 ; ix++){
+            int digit = HexValue(*it++);
+            if (digit < 0) {return false;}
+            out = (out << 4) | (uint32_t) digit;
+        }
+        return true;
+    }
+
+    /**
+     * @return value of the hex digit c, or -1
+     */
+    static int HexValue(const char c) noexcept{
+        if (c >= '0' && c <= '9') {return c - '0';}
+        if (c >= 'a' && c <= 'f') {return c - 'a' + 10;}
+        if (c >= 'A' && c <= 'F') {return c - 'A' + 10;}
+        return -1;
+    }
+
+    /**
+     * writes code_point (at most U+10FFFF) as utf-8.
+     * @return the end of what was written
+     */
+    static char* WriteUtf8(char *dest, const uint32_t code_point) noexcept{
+        if (code_point < 0x80){
+            *dest++ = (char) code_point;
+        } else if (code_point < 0x800){
+            *dest++ = (char) (0xc0 | (code_point >> 6));
+            *dest++ = (char) (0x80 | (code_point & 0x3f));
+        } else if (code_point < 0x10000){
+            *dest++ = (char) (0xe0 | (code_point >> 12));
+            *dest++ = (char) (0x80 | ((code_point >> 6) & 0x3f));
+            *dest++ = (char) (0x80 | (code_point & 0x3f));
+        } else {
+            *dest++ = (char) (0xf0 | (code_point >> 18));
+            *dest++ = (char) (0x80 | ((code_point >> 12) & 0x3f));
+            *dest++ = (char) (0x80 | ((code_point >> 6) & 0x3f));
+            *dest++ = (char) (0x80 | (code_point & 0x3f));
+        }
+        return dest;
+    }
+
+    /**
+     * decoding tables indexed by byte, built once.
+     * hex maps digits to their value, base64 maps the alphabet to 0-63, '=' to BASE64_PAD
+     * and ascii white space to BASE64_SPACE. anything else is CODEC_INVALID.
+     */
+    struct CodecTables{
+        unsigned char hex[256];
+        unsigned char base64[256];
+
+        CodecTables() noexcept{
+            memset(hex, CODEC_INVALID, sizeof(hex));
+            memset(base64, CODEC_INVALID, sizeof(base64));
+            for (int ix = 0 ; ix < 16 ; ix++){
+                hex[(unsigned char) HEX_DIGITS[ix]] = (unsigned char) ix;
+            }
+            for (int ix = 10 ; ix < 16 ; ix++){
+                hex[(unsigned char) ("ABCDEF"[ix - 10])] = (unsigned char) ix;
+            }
+            for (int ix = 0 ; ix < 64 ; ix++){
+                base64[(unsigned char) BASE64_ALPHABET[ix]] = (unsigned char) ix;
+            }
+            base64[(unsigned char) '='] = BASE64_PAD;
+            base64[(unsigned char) ' '] = base64[(unsigned char) '\t'] = BASE64_SPACE;
+            base64[(unsigned char) '\r'] = base64[(unsigned char) '\n'] = BASE64_SPACE;
+        }
+    };
+
+    static const CodecTables& Tables() noexcept{
+        static const CodecTables tables;
+        return tables;
+    }
+
+    /**
+     * cuts the string back to new_size chars (\0 included) after a Grow that was too long.
+     * @return ret, so decoders can end with return Truncate(...)
+     */
+    bool Truncate(const size_t new_size, const bool ret) noexcept{
+        this->size_ = new_size;
+        this->data_[new_size - 1] = '\0';
+        return ret;
+    }
+
+    /**
+     * Grow for the encoders and decoders that read str after growing.
+     * if str points into this string it is moved onto the new buffer.
+     * @param count
+     * @param str
+     * @return pointer to the first new char
+     */
+    CharT* GrowKeeping(const size_t count, ViewType &str) noexcept{
+        if (!Aliases(str)){
+            return Grow(count);
+        }
+        size_t offset = str.Data() - this->data_;
+        CharT *dest = Grow(count);
+        str = ViewType(this->data_ + offset, str.Size());
+        return dest;
+    }
+
+    /**
+     * a piece of the format string, either literal text or an argument.
+     */
+    struct FormatSegment{
+        ViewType literal;
+        size_t arg;
+        bool is_arg;
+        bool hex;
+        size_t double_len;
+        char double_text[DOUBLE_BUF_LEN]; // a double argument, printed while sizing
+    };
+
+    /**
+     * prints the shortest decimal form that reads back as exactly value.
+     * every decimal of up to 15 digits survives a round trip through a double,
+     * so at most 15, 16 and 17 digits have to be tried.
+     * @param buf DOUBLE_BUF_LEN chars
+     * @param value
+     * @return chars written, without the \0
+     */
+    static size_t PrintDouble(char *buf, const double value) noexcept{
+        int len = snprintf(buf, DOUBLE_BUF_LEN, "%.15g", value);
+        if (strtod(buf, nullptr) != value){
+            len = snprintf(buf, DOUBLE_BUF_LEN, "%.16g", value);
+            if (strtod(buf, nullptr) != value){
+                len = snprintf(buf, DOUBLE_BUF_LEN, "%.17g", value);
+            }
+        }
+        return (size_t) len;
+    }
+
+    /**
+     * @return number of hex digits in value
+     */
+    static size_t CountHexDigits(unsigned long long value) noexcept{
+        size_t ret = 1;
+        while (value >>= 4){
+            ret++;
+        }
+        return ret;
+    }
+
+    /**
+     * @return exact length of arg once formatted. doubles are printed to be measured,
+     * FormatArgs does that itself and keeps the text.
+     */
+    static size_t FormatLength(const VLFormatArg &arg, const bool hex) noexcept{
+        switch (arg.kind){
+            case VLFormatArg::SIGNED: {
+                unsigned long long abs_value = arg.signed_value < 0 ? 0ULL - (unsigned long long) arg.signed_value
+                                                                     : (unsigned long long) arg.signed_value;
+                return (arg.signed_value < 0) + (hex ? CountHexDigits(abs_value) : CountDigits(abs_value));
+            }
+            case VLFormatArg::UNSIGNED:
+                return hex ? CountHexDigits(arg.unsigned_value) : CountDigits(arg.unsigned_value);
+            case VLFormatArg::DOUBLE: {
+                char buf[DOUBLE_BUF_LEN];
+                return PrintDouble(buf, arg.double_value);
+            }
+            case VLFormatArg::CHAR:
+                return 1;
+            case VLFormatArg::BOOL:
+                return arg.signed_value ? 4 : 5;
+            default:
+                return arg.string_value.Size();
+        }
+    }
+
+    void AppendFormatArg(const VLFormatArg &arg, const bool hex) noexcept{
+        switch (arg.kind){
+            case VLFormatArg::SIGNED:
+                if (!hex){
+                    AppendInt(arg.signed_value);
+                } else if (arg.signed_value < 0){
+                    PushBack('-');
+                    AppendHex(0ULL - (unsigned long long) arg.signed_value);
+                } else {
+                    AppendHex((unsigned long long) arg.signed_value);
+                }
+                break;
+            case VLFormatArg::UNSIGNED:
+                if (hex){
+                    AppendHex(arg.unsigned_value);
+                } else {
+                    AppendUInt(arg.unsigned_value);
+                }
+                break;
+            case VLFormatArg::DOUBLE:
+                AppendDouble(arg.double_value);
+                break;
+            case VLFormatArg::CHAR:
+                PushBack((char) arg.signed_value);
+                break;
+            case VLFormatArg::BOOL:
+                Append(arg.signed_value ? ViewType("true", 4) : ViewType("false", 5));
+                break;
+            default:
+                Append(arg.string_value);
+        }
+    }
+
+    /**
+     * splits fmt into segments while adding up the output length, grows out once, then writes.
+     * doubles are printed during the sizing pass, so the total is exact, and copied afterwards.
+     * if fmt or a string argument points into out, the growth would leave it dangling,
+     * so the text is formatted into a temporary and appended from there.
+     */
+    static void FormatArgs(VLBasicString &out, const ViewType fmt, const VLFormatArg *args, const size_t arg_count){
+        bool aliased = out.Aliases(fmt);
+        for (size_t ix = 0 ; ix < arg_count && !aliased ; ix++){
+            aliased = args[ix].kind == VLFormatArg::STRING && out.Aliases(args[ix].string_value);
+        }
+        if (aliased){
+            VLBasicString tmp;
+            FormatArgs(tmp, fmt, args, arg_count);
+            out.Append(tmp.View());
+            return;
+        }
+        VLVector<FormatSegment, FORMAT_SEGMENTS> segments;
+        size_t total = 0;
+        size_t next_arg = 0;
+        const char *it = fmt.begin();
+        const char *end = fmt.end();
+        while (it != end){
+            FormatSegment segment = {ViewType(), 0, false, false, 0, {}};
+            const char *brace = it;
+            while (brace != end && *brace != '{' && *brace != '}'){
+                brace++;
+            }
+            if (brace != it){
+                segment.literal = ViewType(it, brace - it);
+                it = brace;
+            } else if (it + 1 != end && it[1] == *it){ // "{{" or "}}"
+                segment.literal = ViewType(it, 1);
+                it += 2;
+            } else if (*it == '{' && it + 1 != end && it[1] == '}'){
+                segment.is_arg = true;
+                it += 2;
+            } else if (*it == '{' && end - it >= 4 && it[1] == ':' && it[2] == 'x' && it[3] == '}'){
+                segment.is_arg = true;
+                segment.hex = true;
+                it += 4;
+            } else {
+                throw std::invalid_argument(BAD_FORMAT);
+            }
+            if (segment.is_arg){
+                if (next_arg == arg_count){
+                    throw std::invalid_argument(BAD_FORMAT);
+                }
+                segment.arg = next_arg++;
+                if (args[segment.arg].kind == VLFormatArg::DOUBLE){
+                    segment.double_len = PrintDouble(segment.double_text, args[segment.arg].double_value);
+                    total += segment.double_len;
+                } else {
+                    total += FormatLength(args[segment.arg], segment.hex);
+                }
+            } else {
+                total += segment.literal.Size();
+            }
+            segments.PushBack(segment);
+        }
+        out.ResizeUp(total);
+        for (const FormatSegment &segment : segments){
+            if (segment.is_arg && args[segment.arg].kind == VLFormatArg::DOUBLE){
+                out.Append(segment.double_text, segment.double_len);
+            } else if (segment.is_arg){
+                out.AppendFormatArg(args[segment.arg], segment.hex);
+            } else {
+                out.Append(segment.literal);
+            }
+        }
+    }
 
     public:
-    typedef char* Iterator;
-    typedef const char* ConstIterator;
+    typedef CharT* Iterator;
+    typedef const CharT* ConstIterator;
     typedef std::reverse_iterator<Iterator> RIterator;
     typedef std::reverse_iterator<ConstIterator> RConstIterator;
 
@@ -16,13 +834,13 @@ class VLString : public VLVector<char,StaticCapacity>{
      * default constructor
      * using single_value Ctor for VLVector
      */
-    VLString(): VLVector<char,StaticCapacity>(1,'\0') {}
+    VLBasicString(): VLVector<CharT,StaticCapacity>(1,'\0') {}
 
     /**
      * implicit CTOR
      * @param string
      */
-    explicit VLString(const char* string): VLVector<char,StaticCapacity>(1, '\0') {
+    explicit VLBasicString(const CharT* string): VLVector<CharT,StaticCapacity>(1, '\0') {
         size_t ix = 0;
         while (string[ix]){
             this->PushBack(string[ix]);
@@ -32,9 +850,23 @@ class VLString : public VLVector<char,StaticCapacity>{
 
     /**
      * Copy CTOR
+     * one growth and one memcpy of the chars and \0, the capacity is the same
+     * the sequence based VLVector CTOR would give.
+     * @param rhs
+     */
+    VLBasicString(const VLBasicString &rhs): VLVector<CharT,StaticCapacity>() {
+        memcpy(VLVector<CharT,StaticCapacity>::Grow(rhs.size_), rhs.data_, rhs.size_ * sizeof(CharT));
+    }
+
+    /**
+     * assignment operator, copies the chars and \0 like VLVector does.
      * @param rhs
+     * @return
      */
-    VLString(const VLString<StaticCapacity> &rhs): VLVector<char,StaticCapacity>(rhs.begin(), rhs.end()+1){}//+1 to enclude \0
+    VLBasicString &operator=(const VLBasicString &rhs){
+        VLVector<CharT,StaticCapacity>::operator=(rhs);
+        return *this;
+    }
 
     /**
      * return the size without \0
@@ -56,7 +888,7 @@ class VLString : public VLVector<char,StaticCapacity>{
     * @param index
     * @return data_[index]
     */
-    char At(size_t index) const override{
+    CharT At(size_t index) const override{
         if (index >= this->Size() || index < 0){
             throw std::out_of_range (BAD_INDEX);
         }
@@ -68,7 +900,7 @@ class VLString : public VLVector<char,StaticCapacity>{
      *
      * @param char to add at the end.
      */
-    void PushBack(const char value) noexcept override{
+    void PushBack(const CharT value) noexcept override{
         this->ResizeUp(1);
         this->data_[this->Size()] = value;
         this->data_[this->size_++] = '\0';
@@ -80,8 +912,8 @@ class VLString : public VLVector<char,StaticCapacity>{
     void PopBack() noexcept override{
         if (this->Size() == 0) {return;}
         this->ResizeDown(this->size_ - 1);
-        (*this)[this->Size()] = '\0';
         this->size_--;
+        this->data_[this->Size()] = '\0'; // over the popped char, so the string stays terminated
     }
 
     /**
@@ -99,51 +931,736 @@ class VLString : public VLVector<char,StaticCapacity>{
 
     }
 
-    VLString operator+(const VLString &rhs){
-        VLString ret(*this);
-        this->cap_ = this->CalculateCapC(rhs.Size());
-        for (size_t ix = 0 ; ix < rhs.Size() ; ix++){
-            ret.PushBack(rhs.data_[ix]);
-        }
-        //this->end is iter to size +1 an we want save \0
-        //rhs.end() because we DONT want its \0
+    /**
+     * adds count chars at the end with at most one reallocation and keeps the \0 after them.
+     * @param count
+     * @return pointer to the first new char, the caller fills count chars from there.
+     */
+    CharT* Grow(const size_t count) noexcept{
+        this->ResizeUp(count);
+        CharT *ret = this->data_ + this->Size();
+        this->size_ += count;
+        this->data_[this->size_ - 1] = '\0';
         return ret;
     }
-    VLString operator+(const char &rhs){
-        VLString ret(*this);
-        ret.PushBack(rhs);
-        return ret;
+
+    /**
+     * @return true if text points into this string's buffer
+     */
+    bool Aliases(const ViewType text) const noexcept{
+        const CharT *begin = this->data_;
+        return !std::less<const CharT*>()(text.Data(), begin) && std::less<const CharT*>()(text.Data(), begin + this->size_);
     }
 
-    VLString operator+(const char* rhs){
-        VLString ret(*this);
-        int ix = 0;
-        size_t original_size = ret.size_;
-        while(rhs[ix]){
-            ret.PushBack(rhs[ix++]);
-        }
-        if (original_size + ix > StaticCapacity){//ix -1 is the num of element we added
-            ret.cap_ = floor(REFACTOR_RATIO * ( (double) original_size + ix));
-            ret.data_ = new char[ret.cap_];
+    /**
+     * appends len chars in one copy.
+     * str may point into this string.
+     * @param str
+     * @param len
+     */
+    void Append(const CharT* str, const size_t len) noexcept{
+        if (len == 0) {return;}
+        bool aliased = Aliases(ViewType(str, len));
+        size_t offset = str - this->data_;
+        CharT *dest = Grow(len);
+        if (aliased){
+            str = this->data_ + offset; // Grow may have moved our buffer
         }
-        return ret;
+        memmove(dest, str, len * sizeof(CharT));
     }
 
-    VLString operator+=(const VLString &rhs){
-         *this = *this + rhs;
-         return *this;
+    void Append(const ViewType str) noexcept{
+        Append(str.Data(), str.Size());
     }
 
-    VLString &operator+=(const char &rhs){
-        this->PushBack(rhs);
+    /**
+     * appends the decimal digits of value, written straight into the buffer.
+     * @param value
+     */
+    void AppendUInt(unsigned long long value) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        size_t len = CountDigits(value);
+        WriteDigits(Grow(len) + len, value);
+    }
+
+    /**
+     * appends value in decimal, with a leading '-' if negative.
+     * @param value
+     */
+    void AppendInt(const long long value) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        // negate in unsigned so LLONG_MIN does not overflow
+        unsigned long long abs_value = value < 0 ? 0ULL - (unsigned long long) value : (unsigned long long) value;
+        size_t len = CountDigits(abs_value);
+        char *dest = Grow(len + (value < 0));
+        if (value < 0){
+            *dest++ = '-';
+        }
+        WriteDigits(dest + len, abs_value);
+    }
+
+    /**
+     * appends value in lowercase hex without a 0x prefix.
+     * @param value
+     */
+    void AppendHex(unsigned long long value) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        size_t len = 1;
+        for (unsigned long long rest = value >> 4 ; rest != 0 ; rest >>= 4){
+            len++;
+        }
+        char *dest = Grow(len) + len;
+        do {
+            *--dest = "0123456789abcdef"[value & 0xf];
+            value >>= 4;
+        } while (value != 0);
+    }
+
+    /**
+     * appends the shortest decimal form that reads back as exactly value.
+     * uses the "C" locale conventions of snprintf / strtod.
+     * @param value
+     */
+    void AppendDouble(const double value) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        char buf[DOUBLE_BUF_LEN];
+        Append(buf, PrintDouble(buf, value));
+    }
+
+    /**
+     * parses the whole string as a decimal integer with an optional sign.
+     * @param out set only on success
+     * @return false on an empty string, a non digit or overflow
+     */
+    bool ParseInt(long long &out) const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        const char *it = this->data_;
+        const char *end = it + this->Size();
+        if (it == end) {return false;}
+        bool negative = *it == '-';
+        if (*it == '-' || *it == '+'){
+            if (++it == end) {return false;}
+        }
+        unsigned long long limit = negative ? (unsigned long long) LLONG_MAX + 1 : (unsigned long long) LLONG_MAX;
+        unsigned long long value = 0;
+        for (; it != end ; ++it){
+            unsigned digit = (unsigned char) *it - '0';
+            if (digit > 9 || value > (limit - digit) / 10){
+                return false;
+            }
+            value = value * 10 + digit;
+        }
+        out = negative ? -(long long) (value - 1) - 1 : (long long) value;
+        return true;
+    }
+
+    /**
+     * parses the whole string as a floating point number.
+     * strtod can read data_ directly since it is always \0 terminated.
+     * @param out set only on success
+     * @return false on an empty string, leading spaces, trailing garbage or overflow
+     */
+    bool ParseDouble(double &out) const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        if (this->Empty() || isspace((unsigned char) this->data_[0])) {return false;}
+        char *end;
+        errno = 0;
+        double value = strtod(this->data_, &end);
+        if (end != this->data_ + this->Size()) {return false;}
+        if (errno == ERANGE && (value == HUGE_VAL || value == -HUGE_VAL)) {return false;}
+        out = value;
+        return true;
+    }
+
+    /**
+     * replaces the len chars at pos with text: at most one growth and one memmove of the tail.
+     * the inherited VLVector Insert / Erase are hidden since they shift one item at a time
+     * and do not keep the \0 in place.
+     * @param pos at most Size()
+     * @param len cut to the end of the string
+     * @param text may point into this string
+     */
+    void Replace(const size_t pos, size_t len, const ViewType text){
+        if (pos > this->Size()){
+            throw std::out_of_range (BAD_INDEX);
+        }
+        if (Aliases(text)){
+            VLBasicString copy;
+            copy.Append(text);
+            Replace(pos, len, copy.View());
+            return;
+        }
+        if (len > this->Size() - pos){
+            len = this->Size() - pos;
+        }
+        if (text.Size() > len){
+            this->ResizeUp(text.Size() - len);
+        }
+        CharT *at = this->data_ + pos;
+        memmove(at + text.Size(), at + len, (this->size_ - pos - len) * sizeof(CharT)); // the tail and its \0
+        memcpy(at, text.Data(), text.Size() * sizeof(CharT));
+        this->size_ = this->size_ - len + text.Size();
+        if (text.Size() < len){
+            this->ResizeDown(this->size_);
+        }
+    }
+
+    /**
+     * inserts text before the char at pos.
+     * @param pos at most Size()
+     * @param text
+     */
+    void Insert(const size_t pos, const ViewType text){
+        Replace(pos, 0, text);
+    }
+
+    /**
+     * removes up to len chars starting at pos.
+     * @param pos at most Size()
+     * @param len
+     */
+    void Erase(const size_t pos, const size_t len){
+        Replace(pos, len, ViewType());
+    }
+
+    /**
+     * replaces every non overlapping occurrence of from with to.
+     * one scan finds the matches and fixes the final length, then the string grows
+     * at most once and every char is moved once: left to right when the result
+     * is not longer, right to left (into the grown buffer) when it is.
+     * @param from must not be empty
+     * @param to
+     * @return number of replacements
+     */
+    size_t ReplaceAll(const ViewType from, const ViewType to){
+        if (from.Empty()) {return 0;}
+        if (Aliases(from) || Aliases(to)){
+            VLBasicString from_copy, to_copy;
+            from_copy.Append(from);
+            to_copy.Append(to);
+            return ReplaceAll(from_copy.View(), to_copy.View());
+        }
+        VLVector<size_t> matches;
+        for (size_t pos = Find(from) ; pos != NOT_FOUND ; pos = Find(from, pos + from.Size())){
+            matches.PushBack(pos);
+        }
+        size_t count = matches.Size();
+        if (count == 0) {return 0;}
+        size_t old_size = this->Size();
+        if (to.Size() <= from.Size()){
+            CharT *dest = this->data_ + matches[0];
+            for (size_t ix = 0 ; ix < count ; ix++){
+                memcpy(dest, to.Data(), to.Size() * sizeof(CharT));
+                dest += to.Size();
+                const CharT *src = this->data_ + matches[ix] + from.Size();
+                const CharT *src_end = this->data_ + (ix + 1 < count ? matches[ix + 1] : old_size);
+                memmove(dest, src, (src_end - src) * sizeof(CharT));
+                dest += src_end - src;
+            }
+            *dest = '\0';
+            this->size_ = dest - this->data_ + 1;
+            this->ResizeDown(this->size_);
+        } else {
+            size_t growth = count * (to.Size() - from.Size());
+            this->ResizeUp(growth);
+            CharT *dest = this->data_ + old_size + growth;
+            *dest = '\0';
+            for (size_t ix = count ; ix-- > 0 ;){
+                const CharT *src = this->data_ + matches[ix] + from.Size();
+                const CharT *src_end = this->data_ + (ix + 1 < count ? matches[ix + 1] : old_size);
+                dest -= src_end - src;
+                memmove(dest, src, (src_end - src) * sizeof(CharT));
+                dest -= to.Size();
+                memcpy(dest, to.Data(), to.Size() * sizeof(CharT));
+            }
+            this->size_ += growth;
+        }
+        return count;
+    }
+
+    /**
+     * turns ascii upper case letters to lower case in place, 8 chars at a time.
+     * other bytes (including utf-8 sequences) are left as they are.
+     */
+    void ToLowerAscii() noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        size_t ix = 0;
+        for (; ix + 8 <= this->Size() ; ix += 8){
+            SwarStore(this->data_ + ix, SwarToLowerAscii(SwarLoad(this->data_ + ix)));
+        }
+        for (; ix < this->Size() ; ix++){
+            if (this->data_[ix] >= 'A' && this->data_[ix] <= 'Z'){
+                this->data_[ix] += 'a' - 'A';
+            }
+        }
+    }
+
+    /**
+     * turns ascii lower case letters to upper case in place, 8 chars at a time.
+     */
+    void ToUpperAscii() noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        size_t ix = 0;
+        for (; ix + 8 <= this->Size() ; ix += 8){
+            SwarStore(this->data_ + ix, SwarToUpperAscii(SwarLoad(this->data_ + ix)));
+        }
+        for (; ix < this->Size() ; ix++){
+            if (this->data_[ix] >= 'a' && this->data_[ix] <= 'z'){
+                this->data_[ix] -= 'a' - 'A';
+            }
+        }
+    }
+
+    /**
+     * the trim functions do not copy, the views are valid until the next mutation.
+     */
+    ViewType TrimLeft() const noexcept{
+        return View().TrimLeft();
+    }
+
+    ViewType TrimRight() const noexcept{
+        return View().TrimRight();
+    }
+
+    ViewType TrimBoth() const noexcept{
+        return View().TrimBoth();
+    }
+
+    bool EqualsIgnoreCaseAscii(const ViewType &rhs) const noexcept{
+        return View().EqualsIgnoreCaseAscii(rhs);
+    }
+
+    bool IsValidUtf8() const noexcept{
+        return View().IsValidUtf8();
+    }
+
+    size_t CodePointCount() const noexcept{
+        return View().CodePointCount();
+    }
+
+    /**
+     * @return range of the code points, valid until the next mutation
+     */
+    VLCodePointRange CodePoints() const noexcept{
+        return View().CodePoints();
+    }
+
+    /**
+     * appends str escaped for a JSON string body (no surrounding quotes).
+     * a first pass classifies 8 bytes at a time and counts the extra bytes the escapes
+     * need, then the string grows once. clean input is copied with a single memcpy,
+     * otherwise clean runs are memcpy'd and only '"', '\\' and control chars are escaped.
+     * @param str may point into this string
+     */
+    void AppendJsonEscaped(ViewType str) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        size_t extra = 0;
+        size_t ix = 0;
+        for (; ix + 8 <= str.Size() ; ix += 8){
+            uint64_t special = JsonSpecialBytes(SwarLoad(str.Data() + ix));
+            while (special){
+                extra += JsonEscapeExtra(str[ix + SwarLowestByte(special)]);
+                special &= special - 1; // every special byte has only its high bit set in the mask
+            }
+        }
+        for (; ix < str.Size() ; ix++){
+            extra += JsonEscapeExtra(str[ix]);
+        }
+        char *dest = GrowKeeping(str.Size() + extra, str);
+        if (extra == 0){
+            memcpy(dest, str.Data(), str.Size());
+            return;
+        }
+        const char *it = str.Data();
+        const char *end = it + str.Size();
+        while (it != end){
+            const char *run = it;
+            while (end - it >= 8 && JsonSpecialBytes(SwarLoad(it)) == 0){
+                it += 8;
+            }
+            while (it != end && JsonEscapeExtra(*it) == 0){
+                it++;
+            }
+            memcpy(dest, run, it - run);
+            dest += it - run;
+            if (it == end) {break;}
+            dest = WriteJsonEscape(dest, (unsigned char) *it++);
+        }
+    }
+
+    /**
+     * appends the JSON string body str with its escapes decoded, \uXXXX (and surrogate pairs) as utf-8.
+     * runs without a backslash are found with memchr and memcpy'd.
+     * @param str may point into this string
+     * @return false on a bad escape, the string is left as it was then
+     */
+    bool AppendJsonUnescaped(ViewType str) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        size_t old_size = this->size_;
+        char *begin = GrowKeeping(str.Size(), str); // the decoded text is never longer
+        char *dest = begin;
+        const char *it = str.Data();
+        const char *end = it + str.Size();
+        while (it != end){
+            const char *slash = (const char*) memchr(it, '\\', end - it);
+            const char *run_end = slash ? slash : end;
+            memcpy(dest, it, run_end - it);
+            dest += run_end - it;
+            if (!slash) {break;}
+            it = slash + 1;
+            if (it == end) {return Truncate(old_size, false);}
+            char escaped = *it++;
+            switch (escaped){
+                case '"': *dest++ = '"'; break;
+                case '\\': *dest++ = '\\'; break;
+                case '/': *dest++ = '/'; break;
+                case 'b': *dest++ = '\b'; break;
+                case 'f': *dest++ = '\f'; break;
+                case 'n': *dest++ = '\n'; break;
+                case 'r': *dest++ = '\r'; break;
+                case 't': *dest++ = '\t'; break;
+                case 'u': {
+                    uint32_t code_point;
+                    if (!ReadHex4(it, end, code_point)) {return Truncate(old_size, false);}
+                    if (code_point >= 0xd800 && code_point <= 0xdbff){ // high surrogate, a low one must follow
+                        uint32_t low;
+                        if (end - it < 2 || it[0] != '\\' || it[1] != 'u') {return Truncate(old_size, false);}
+                        it += 2;
+                        if (!ReadHex4(it, end, low) || low < 0xdc00 || low > 0xdfff){
+                            return Truncate(old_size, false);
+                        }
+                        code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+                    } else if (code_point >= 0xdc00 && code_point <= 0xdfff){
+                        return Truncate(old_size, false);
+                    }
+                    dest = WriteUtf8(dest, code_point);
+                    break;
+                }
+                default:
+                    return Truncate(old_size, false);
+            }
+        }
+        return Truncate(old_size + (dest - begin), true);
+    }
+
+    /**
+     * appends str as a CSV field: as it is when it has no ',', '"', \r or \n,
+     * otherwise in quotes with every '"' doubled. the check runs 8 bytes at a time.
+     * @param str may point into this string
+     */
+    void AppendCsvQuoted(ViewType str) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        size_t quotes = 0;
+        bool special = false;
+        size_t ix = 0;
+        for (; ix + 8 <= str.Size() ; ix += 8){
+            uint64_t word = SwarLoad(str.Data() + ix);
+            uint64_t quote_mask = SwarEqualBytes(word, '"');
+            quotes += VLPopCount64(quote_mask);
+            special |= (quote_mask | SwarEqualBytes(word, ',') | SwarEqualBytes(word, '\n')
+                        | SwarEqualBytes(word, '\r')) != 0;
+        }
+        for (; ix < str.Size() ; ix++){
+            char c = str[ix];
+            quotes += c == '"';
+            special |= c == '"' || c == ',' || c == '\n' || c == '\r';
+        }
+        if (!special){
+            Append(str);
+            return;
+        }
+        char *dest = GrowKeeping(str.Size() + quotes + 2, str);
+        *dest++ = '"';
+        const char *it = str.Data();
+        const char *end = it + str.Size();
+        while (it != end){
+            const char *quote = (const char*) memchr(it, '"', end - it);
+            const char *run_end = quote ? quote + 1 : end; // the quote itself is copied with its run
+            memcpy(dest, it, run_end - it);
+            dest += run_end - it;
+            if (quote){
+                *dest++ = '"';
+            }
+            it = run_end;
+        }
+        *dest = '"';
+    }
+
+    /**
+     * appends the value of the CSV field str: a quoted field loses its quotes
+     * and its doubled '"' become one, anything else is copied as it is.
+     * @param str may point into this string
+     * @return false on a quoted field with a lone '"' or no closing quote, the string is left as it was then
+     */
+    bool AppendCsvUnquoted(ViewType str) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        if (str.Empty() || str[0] != '"'){
+            Append(str);
+            return true;
+        }
+        if (str.Size() < 2 || str[str.Size() - 1] != '"'){
+            return false;
+        }
+        size_t old_size = this->size_;
+        char *begin = GrowKeeping(str.Size() - 2, str);
+        char *dest = begin;
+        const char *it = str.Data() + 1;
+        const char *end = str.Data() + str.Size() - 1;
+        while (it != end){
+            const char *quote = (const char*) memchr(it, '"', end - it);
+            const char *run_end = quote ? quote + 1 : end;
+            memcpy(dest, it, run_end - it);
+            dest += run_end - it;
+            if (!quote) {break;}
+            if (run_end == end || *run_end != '"') {return Truncate(old_size, false);}
+            it = run_end + 1; // skip the second quote of the pair
+        }
+        return Truncate(old_size + (dest - begin), true);
+    }
+
+    /**
+     * appends bytes as lowercase hex, two digits per byte, after a single growth.
+     * @param bytes
+     * @param len
+     */
+    void AppendHex(const uint8_t *bytes, const size_t len) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        char *dest = Grow(len * 2);
+        for (size_t ix = 0 ; ix < len ; ix++){
+            *dest++ = HEX_DIGITS[bytes[ix] >> 4];
+            *dest++ = HEX_DIGITS[bytes[ix] & 0xf];
+        }
+    }
+
+    template<size_t M>
+    void AppendHex(const VLVector<uint8_t, M> &bytes) noexcept{
+        AppendHex(bytes.Data(), bytes.Size());
+    }
+
+    /**
+     * decodes this string as hex (either case) into the end of out, which grows once.
+     * @param out
+     * @return false on an odd length or a non hex char, out is left as it was then
+     */
+    template<size_t M>
+    bool DecodeHex(VLVector<uint8_t, M> &out) const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        const unsigned char *table = Tables().hex;
+        const unsigned char *it = (const unsigned char*) this->data_;
+        size_t len = Size();
+        if (len % 2 != 0) {return false;}
+        for (size_t ix = 0 ; ix < len ; ix++){
+            if (table[it[ix]] == CODEC_INVALID) {return false;}
+        }
+        uint8_t *dest = out.Grow(len / 2);
+        for (size_t ix = 0 ; ix < len ; ix += 2){
+            *dest++ = (uint8_t) ((table[it[ix]] << 4) | table[it[ix + 1]]);
+        }
+        return true;
+    }
+
+    /**
+     * appends bytes as padded standard base64 (RFC 4648) after a single growth.
+     * @param bytes
+     * @param len
+     */
+    void AppendBase64(const uint8_t *bytes, const size_t len) noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        char *dest = Grow((len + 2) / 3 * 4);
+        size_t ix = 0;
+        for (; ix + 3 <= len ; ix += 3){
+            uint32_t triple = ((uint32_t) bytes[ix] << 16) | ((uint32_t) bytes[ix + 1] << 8) | bytes[ix + 2];
+            *dest++ = BASE64_ALPHABET[triple >> 18];
+            *dest++ = BASE64_ALPHABET[(triple >> 12) & 0x3f];
+            *dest++ = BASE64_ALPHABET[(triple >> 6) & 0x3f];
+            *dest++ = BASE64_ALPHABET[triple & 0x3f];
+        }
+        if (ix == len) {return;}
+        uint32_t triple = (uint32_t) bytes[ix] << 16;
+        if (len - ix == 2){
+            triple |= (uint32_t) bytes[ix + 1] << 8;
+        }
+        *dest++ = BASE64_ALPHABET[triple >> 18];
+        *dest++ = BASE64_ALPHABET[(triple >> 12) & 0x3f];
+        *dest++ = len - ix == 2 ? BASE64_ALPHABET[(triple >> 6) & 0x3f] : '=';
+        *dest = '=';
+    }
+
+    template<size_t M>
+    void AppendBase64(const VLVector<uint8_t, M> &bytes) noexcept{
+        AppendBase64(bytes.Data(), bytes.Size());
+    }
+
+    /**
+     * decodes this string as standard base64 into the end of out, which grows once.
+     * strict wants canonical input: padded to a multiple of 4, no white space, and zero unused bits.
+     * lenient skips white space and accepts missing padding and non zero unused bits.
+     * @param out
+     * @param lenient
+     * @return false on bad input, out is left as it was then
+     */
+    template<size_t M>
+    bool DecodeBase64(VLVector<uint8_t, M> &out, const bool lenient = false) const noexcept{
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        const unsigned char *table = Tables().base64;
+        const unsigned char *it = (const unsigned char*) this->data_;
+        size_t len = Size();
+        size_t digits = 0;
+        size_t pads = 0;
+        unsigned char last = 0;
+        for (size_t ix = 0 ; ix < len ; ix++){
+            unsigned char value = table[it[ix]];
+            if (value < 64){
+                if (pads != 0) {return false;} // data after the padding
+                digits++;
+                last = value;
+            } else if (value == BASE64_PAD){
+                pads++;
+            } else if (!lenient || value != BASE64_SPACE){
+                return false;
+            }
+        }
+        if (pads > 2 || digits % 4 == 1){
+            return false;
+        }
+        if ((!lenient || pads != 0) && (digits + pads) % 4 != 0){
+            return false;
+        }
+        if (!lenient && ((digits % 4 == 2 && (last & 0xf)) || (digits % 4 == 3 && (last & 0x3)))){
+            return false;
+        }
+        uint8_t *dest = out.Grow(digits * 3 / 4);
+        uint32_t bits = 0;
+        size_t bit_count = 0;
+        for (size_t ix = 0 ; ix < len ; ix++){
+            unsigned char value = table[it[ix]];
+            if (value >= 64) {continue;}
+            bits = (bits << 6) | value;
+            bit_count += 6;
+            if (bit_count >= 8){
+                bit_count -= 8;
+                *dest++ = (uint8_t) (bits >> bit_count);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * formats into a new string, see FormatTo.
+     * @return the formatted string
+     */
+    template<class... Args>
+    static VLBasicString Format(const ViewType fmt, const Args&... args){
+        VLBasicString ret;
+        FormatTo(ret, fmt, args...);
+        return ret;
+    }
+
+    /**
+     * appends fmt to out with every "{}" replaced by the next argument.
+     * "{:x}" prints an integer in hex, "{{" and "}}" print a single brace.
+     * the output size is summed up first, exactly (doubles are printed to a stack buffer
+     * on the way) and out grows at most once, so short results stay in the static buffer.
+     * arguments may be integers, bool, char, double, const char*, ViewType or VLBasicString,
+     * out itself included.
+     * @throws std::invalid_argument on a bad placeholder or a missing argument
+     */
+    template<class... Args>
+    static void FormatTo(VLBasicString &out, const ViewType fmt, const Args&... args){
+        static_assert(std::is_same<CharT, char>::value, CHAR_ONLY);
+        const VLFormatArg arg_list[] = {VLFormatArg(args)..., VLFormatArg()}; // the last one keeps it non empty
+        FormatArgs(out, fmt, arg_list, sizeof...(Args));
+    }
+
+    VLBasicString operator+(const VLBasicString &rhs){
+        VLBasicString ret(*this);
+        ret.Append(rhs.View());
+        return ret;
+    }
+    VLBasicString operator+(const CharT &rhs){
+        VLBasicString ret(*this);
+        ret.PushBack(rhs);
+        return ret;
+    }
+
+    VLBasicString operator+(const CharT* rhs){
+        VLBasicString ret(*this);
+        ret.Append(ViewType(rhs));
+        return ret;
+    }
+
+    VLBasicString &operator+=(const VLBasicString &rhs){
+        this->Append(rhs.View());
+        return *this;
+    }
+
+    VLBasicString &operator+=(const CharT &rhs){
+        this->PushBack(rhs);
          return *this;
     }
 
-    VLString operator+=(const char* rhs){
-        *this = *this + rhs;
+    VLBasicString &operator+=(const CharT* rhs){
+        this->Append(ViewType(rhs));
         return *this;
     }
 
+    /**
+     * compares the characters only. the inherited VLVector::operator== also compares
+     * the capacity, which would make equal strings hash equal but compare unequal.
+     * @param rhs
+     * @return
+     */
+    bool operator==(const VLBasicString &rhs) const noexcept {
+        return this->size_ == rhs.size_ && memcmp(this->data_, rhs.data_, this->Size() * sizeof(CharT)) == 0;
+    }
+
+    bool operator!=(const VLBasicString &rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+    /**
+     * see ViewType::Compare.
+     * a VLBasicString, ViewType or const char* can be passed, none of them is copied.
+     */
+    int Compare(const ViewType &rhs) const noexcept{
+        return View().Compare(rhs);
+    }
+
+    size_t Find(const ViewType &needle, const size_t from = 0) const noexcept{
+        return View().Find(needle, from);
+    }
+
+    bool StartsWith(const ViewType &prefix) const noexcept{
+        return View().StartsWith(prefix);
+    }
+
+    bool EndsWith(const ViewType &suffix) const noexcept{
+        return View().EndsWith(suffix);
+    }
+
+    bool operator<(const VLBasicString &rhs) const noexcept{
+        return View().Compare(rhs.View()) < 0;
+    }
+
+    /**
+     * @return a view over the characters, without \0.
+     * it is valid until the next mutation of this string.
+     */
+    ViewType View() const noexcept {
+        return ViewType(this->data_, this->Size());
+    }
+
+    operator ViewType() const noexcept {
+        return View();
+    }
+
+    /**
+     * @return hash of the characters (without \0), same as std::hash<VLBasicString>.
+     */
+    size_t Hash() const noexcept {
+        return VLHashBytes(this->data_, this->Size() * sizeof(CharT));
+    }
+
 
     /**
      * we must override these iterators so we will not return \0
@@ -168,4 +1685,677 @@ class VLString : public VLVector<char,StaticCapacity>{
 
 };
 
+/**
+ * the string types. StaticCapacity counts bytes for all of them,
+ * so the static buffer of every alias takes the same room as VLString's.
+ */
+template <size_t StaticCapacity = START_CAP>
+using VLString = VLBasicString<char, StaticCapacity>;
+
+template <size_t StaticCapacity = START_CAP>
+using VLU16String = VLBasicString<char16_t, StaticCapacity / sizeof(char16_t)>;
+
+template <size_t StaticCapacity = START_CAP>
+using VLU32String = VLBasicString<char32_t, StaticCapacity / sizeof(char32_t)>;
+
+/**
+ * a VLString that remembers its hash.
+ * the hash is computed on the first Hash() call and dropped by every mutating member.
+ * VLString is a private base, like for VLCowString, so every mutation goes through a member
+ * here that drops the hash. only the read only members are exported as they are.
+ */
+template <size_t StaticCapacity = START_CAP>
+class VLHashedString : private VLString<StaticCapacity>{
+
+    typedef VLString<StaticCapacity> Base;
+
+    mutable size_t hash_;
+    mutable bool hash_valid_;
+
+    public:
+
+    VLHashedString(): Base(), hash_(0), hash_valid_(false) {}
+
+    explicit VLHashedString(const char* string): Base(string), hash_(0), hash_valid_(false) {}
+
+    VLHashedString(const Base &rhs): Base(rhs), hash_(0), hash_valid_(false) {}
+
+    /**
+     * @return the cached hash, computing it if a mutation dropped it.
+     */
+    size_t Hash() const noexcept {
+        if (!hash_valid_){
+            hash_ = Base::Hash();
+            hash_valid_ = true;
+        }
+        return hash_;
+    }
+
+    /**
+     * @return a plain VLString copy
+     */
+    Base ToVLString() const{
+        return Base(*this);
+    }
+
+    using Base::Size;
+    using Base::Capacity;
+    using Base::Empty;
+    using Base::At;
+    using Base::View;
+    using Base::operator VLStringView;
+    using Base::Compare;
+    using Base::Find;
+    using Base::StartsWith;
+    using Base::EndsWith;
+    using Base::TrimLeft;
+    using Base::TrimRight;
+    using Base::TrimBoth;
+    using Base::EqualsIgnoreCaseAscii;
+    using Base::IsValidUtf8;
+    using Base::CodePointCount;
+    using Base::CodePoints;
+    using Base::ParseInt;
+    using Base::ParseDouble;
+    using Base::DecodeHex;
+    using Base::DecodeBase64;
+
+    const char* Data() const noexcept{
+        return this->data_;
+    }
+
+    /**
+     * only const iteration is exported, the mutable begin() / end() would keep a stale hash.
+     * iterate through View() or the const iterators.
+     */
+    using Base::cbegin;
+    using Base::cend;
+
+    char operator[](const size_t index) const noexcept{
+        return this->data_[index];
+    }
+
+    /**
+     * the returned reference may be written to, so the hash is dropped.
+     */
+    char& operator[](const size_t index) noexcept{
+        hash_valid_ = false;
+        return this->data_[index];
+    }
+
+    void PushBack(const char value) noexcept override{
+        Base::PushBack(value);
+        hash_valid_ = false;
+    }
+
+    void PopBack() noexcept override{
+        Base::PopBack();
+        hash_valid_ = false;
+    }
+
+    void Clear() noexcept override{
+        Base::Clear();
+        hash_valid_ = false;
+    }
+
+    void Append(const char* str, const size_t len) noexcept{
+        Base::Append(str, len);
+        hash_valid_ = false;
+    }
+
+    void Append(const VLStringView str) noexcept{
+        Base::Append(str);
+        hash_valid_ = false;
+    }
+
+    void AppendInt(const long long value) noexcept{
+        Base::AppendInt(value);
+        hash_valid_ = false;
+    }
+
+    void AppendUInt(const unsigned long long value) noexcept{
+        Base::AppendUInt(value);
+        hash_valid_ = false;
+    }
+
+    void AppendHex(const unsigned long long value) noexcept{
+        Base::AppendHex(value);
+        hash_valid_ = false;
+    }
+
+    void AppendDouble(const double value) noexcept{
+        Base::AppendDouble(value);
+        hash_valid_ = false;
+    }
+
+    void AppendJsonEscaped(const VLStringView str) noexcept{
+        Base::AppendJsonEscaped(str);
+        hash_valid_ = false;
+    }
+
+    bool AppendJsonUnescaped(const VLStringView str) noexcept{
+        hash_valid_ = false;
+        return Base::AppendJsonUnescaped(str);
+    }
+
+    void AppendCsvQuoted(const VLStringView str) noexcept{
+        Base::AppendCsvQuoted(str);
+        hash_valid_ = false;
+    }
+
+    bool AppendCsvUnquoted(const VLStringView str) noexcept{
+        hash_valid_ = false;
+        return Base::AppendCsvUnquoted(str);
+    }
+
+    void AppendHex(const uint8_t *bytes, const size_t len) noexcept{
+        Base::AppendHex(bytes, len);
+        hash_valid_ = false;
+    }
+
+    template<size_t M>
+    void AppendHex(const VLVector<uint8_t, M> &bytes) noexcept{
+        Base::AppendHex(bytes);
+        hash_valid_ = false;
+    }
+
+    void AppendBase64(const uint8_t *bytes, const size_t len) noexcept{
+        Base::AppendBase64(bytes, len);
+        hash_valid_ = false;
+    }
+
+    template<size_t M>
+    void AppendBase64(const VLVector<uint8_t, M> &bytes) noexcept{
+        Base::AppendBase64(bytes);
+        hash_valid_ = false;
+    }
+
+    void Replace(const size_t pos, const size_t len, const VLStringView text){
+        hash_valid_ = false;
+        Base::Replace(pos, len, text);
+    }
+
+    void Insert(const size_t pos, const VLStringView text){
+        hash_valid_ = false;
+        Base::Insert(pos, text);
+    }
+
+    void Erase(const size_t pos, const size_t len){
+        hash_valid_ = false;
+        Base::Erase(pos, len);
+    }
+
+    size_t ReplaceAll(const VLStringView from, const VLStringView to){
+        hash_valid_ = false;
+        return Base::ReplaceAll(from, to);
+    }
+
+    void ToLowerAscii() noexcept{
+        Base::ToLowerAscii();
+        hash_valid_ = false;
+    }
+
+    void ToUpperAscii() noexcept{
+        Base::ToUpperAscii();
+        hash_valid_ = false;
+    }
+
+    VLHashedString &operator+=(const VLStringView rhs){
+        Append(rhs);
+        return *this;
+    }
+
+    VLHashedString &operator+=(const char &rhs){
+        PushBack(rhs);
+        return *this;
+    }
+
+    /**
+     * two cached hashes that differ settle the comparison without touching the characters.
+     */
+    bool operator==(const VLHashedString &rhs) const noexcept {
+        if (hash_valid_ && rhs.hash_valid_ && hash_ != rhs.hash_){
+            return false;
+        }
+        return View() == rhs.View();
+    }
+
+    bool operator!=(const VLHashedString &rhs) const noexcept {
+        return !(*this == rhs);
+    }
+};
+
+/**
+ * an opt in copy on write VLString.
+ * copies of a heap allocated string share its buffer through a reference count,
+ * the buffer is cloned only when one of the copies is first mutated.
+ * short strings live in the static buffer and are copied as usual.
+ * VLString is a private base so that every mutation goes through a member here
+ * that detaches first, only the read only members are exported as they are.
+ * the reference count is attached to the source by its first copy and published with a
+ * compare and swap, so a const string may be copied from several threads at once.
+ */
+template <size_t StaticCapacity = START_CAP>
+class VLCowString : private VLString<StaticCapacity>{
+
+    typedef VLString<StaticCapacity> Base;
+
+    struct SharedBuffer{
+        std::atomic<size_t> refs;
+        explicit SharedBuffer(const size_t count): refs(count) {}
+    };
+
+    // null when data_ is not shared with anyone. atomic since copies of a const string
+    // attach it to the source, possibly from several threads.
+    mutable std::atomic<SharedBuffer*> shared_;
+
+    /**
+     * drops this string's hold on its buffer and leaves it as an empty static string.
+     */
+    void Release() noexcept{
+        SharedBuffer *shared = shared_.load(std::memory_order_acquire);
+        if (shared){
+            if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                delete[] this->data_;
+                delete shared;
+            }
+            shared_.store(nullptr, std::memory_order_relaxed);
+        } else if (this->is_alloc_){
+            delete[] this->data_;
+        }
+        this->is_alloc_ = false;
+        this->data_ = &this->static_data_[0];
+        this->cap_ = StaticCapacity;
+        this->size_ = 1;
+        this->static_data_[0] = '\0';
+    }
+
+    /**
+     * takes rhs's content, sharing its buffer if it is on the heap.
+     * assumes this is an empty static string.
+     * the first copy of rhs gives it a reference count. two threads copying rhs at once
+     * race to install theirs: the loser deletes its block and takes the winner's.
+     */
+    void ShareFrom(const VLCowString &rhs){
+        if (!rhs.is_alloc_){
+            memcpy(this->static_data_, rhs.data_, rhs.size_);
+            this->size_ = rhs.size_;
+            return;
+        }
+        SharedBuffer *shared = rhs.shared_.load(std::memory_order_acquire);
+        if (!shared){
+            SharedBuffer *fresh = new SharedBuffer(1);
+            if (rhs.shared_.compare_exchange_strong(shared, fresh, std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)){
+                shared = fresh;
+            } else {
+                delete fresh; // shared now holds the block another copy installed
+            }
+        }
+        shared->refs.fetch_add(1, std::memory_order_relaxed);
+        shared_.store(shared, std::memory_order_relaxed);
+        this->data_ = rhs.data_;
+        this->size_ = rhs.size_;
+        this->cap_ = rhs.cap_;
+        this->is_alloc_ = true;
+    }
+
+    /**
+     * makes data_ owned by this string only, cloning it if someone else still uses it.
+     * the clone is made before letting go of the reference so the buffer can not vanish mid copy.
+     */
+    void Detach(){
+        SharedBuffer *shared = shared_.load(std::memory_order_acquire);
+        if (!shared) {return;}
+        if (shared->refs.load(std::memory_order_acquire) == 1){
+            delete shared;
+            shared_.store(nullptr, std::memory_order_relaxed);
+            return;
+        }
+        char *copy = new char[this->cap_];
+        memcpy(copy, this->data_, this->size_);
+        if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            delete[] this->data_;
+            delete shared;
+        }
+        this->data_ = copy;
+        shared_.store(nullptr, std::memory_order_relaxed);
+    }
+
+    public:
+
+    VLCowString(): Base(), shared_(nullptr) {}
+
+    explicit VLCowString(const char* string): Base(string), shared_(nullptr) {}
+
+    VLCowString(const Base &rhs): Base(rhs), shared_(nullptr) {}
+
+    /**
+     * O(1) for heap allocated strings.
+     * @param rhs
+     */
+    VLCowString(const VLCowString &rhs): Base(), shared_(nullptr) {
+        ShareFrom(rhs);
+    }
+
+    VLCowString &operator=(const VLCowString &rhs){
+        SharedBuffer *shared = shared_.load(std::memory_order_acquire);
+        if (this == &rhs || (shared && shared == rhs.shared_.load(std::memory_order_acquire))){
+            return *this;
+        }
+        Release();
+        ShareFrom(rhs);
+        return *this;
+    }
+
+    ~VLCowString(){
+        Release(); // leaves is_alloc_ false, so ~VLVector has nothing left to free
+    }
+
+    /**
+     * @return true if the buffer is currently shared with another copy
+     */
+    bool IsShared() const noexcept{
+        SharedBuffer *shared = shared_.load(std::memory_order_acquire);
+        return shared && shared->refs.load(std::memory_order_acquire) > 1;
+    }
+
+    /**
+     * @return a plain VLString copy
+     */
+    Base ToVLString() const{
+        return Base(*this);
+    }
+
+    using Base::Size;
+    using Base::Capacity;
+    using Base::Empty;
+    using Base::At;
+    using Base::View;
+    using Base::operator VLStringView;
+    using Base::Hash;
+    using Base::Compare;
+    using Base::Find;
+    using Base::StartsWith;
+    using Base::EndsWith;
+    using Base::TrimLeft;
+    using Base::TrimRight;
+    using Base::TrimBoth;
+    using Base::EqualsIgnoreCaseAscii;
+    using Base::IsValidUtf8;
+    using Base::CodePointCount;
+    using Base::CodePoints;
+    using Base::ParseInt;
+    using Base::ParseDouble;
+    using Base::DecodeHex;
+    using Base::DecodeBase64;
+
+    const char* Data() const noexcept{
+        return this->data_;
+    }
+
+    /**
+     * only const iteration is exported, the mutable begin() / end() would bypass Detach.
+     * iterate through View() or the const iterators.
+     */
+    using Base::cbegin;
+    using Base::cend;
+
+    char operator[](const size_t index) const noexcept{
+        return this->data_[index];
+    }
+
+    /**
+     * the returned reference may be written to, so the buffer is detached first.
+     */
+    char& operator[](const size_t index){
+        Detach();
+        return this->data_[index];
+    }
+
+    void PushBack(const char value) noexcept override{
+        Detach();
+        Base::PushBack(value);
+    }
+
+    void PopBack() noexcept override{
+        Detach();
+        Base::PopBack();
+    }
+
+    /**
+     * a shared buffer is just let go, there is nothing to clone.
+     */
+    void Clear() noexcept override{
+        Release();
+    }
+
+    void Append(const char* str, const size_t len){
+        Detach();
+        Base::Append(str, len);
+    }
+
+    void Append(const VLStringView str){
+        Detach();
+        Base::Append(str);
+    }
+
+    void AppendInt(const long long value){
+        Detach();
+        Base::AppendInt(value);
+    }
+
+    void AppendUInt(const unsigned long long value){
+        Detach();
+        Base::AppendUInt(value);
+    }
+
+    void AppendHex(const unsigned long long value){
+        Detach();
+        Base::AppendHex(value);
+    }
+
+    void AppendDouble(const double value){
+        Detach();
+        Base::AppendDouble(value);
+    }
+
+    void Replace(const size_t pos, const size_t len, const VLStringView text){
+        Detach();
+        Base::Replace(pos, len, text);
+    }
+
+    void Insert(const size_t pos, const VLStringView text){
+        Detach();
+        Base::Insert(pos, text);
+    }
+
+    void Erase(const size_t pos, const size_t len){
+        Detach();
+        Base::Erase(pos, len);
+    }
+
+    size_t ReplaceAll(const VLStringView from, const VLStringView to){
+        Detach();
+        return Base::ReplaceAll(from, to);
+    }
+
+    void ToLowerAscii(){
+        Detach();
+        Base::ToLowerAscii();
+    }
+
+    void ToUpperAscii(){
+        Detach();
+        Base::ToUpperAscii();
+    }
+
+    VLCowString &operator+=(const VLStringView rhs){
+        Append(rhs);
+        return *this;
+    }
+
+    VLCowString &operator+=(const char &rhs){
+        PushBack(rhs);
+        return *this;
+    }
+
+    /**
+     * two copies of one shared buffer are equal without looking at it.
+     */
+    bool operator==(const VLCowString &rhs) const noexcept{
+        if (this->data_ == rhs.data_ && this->size_ == rhs.size_){
+            return true;
+        }
+        return View() == rhs.View();
+    }
+
+    bool operator!=(const VLCowString &rhs) const noexcept{
+        return !(*this == rhs);
+    }
+};
+
+/**
+ * a char buffer for building text that tracks its length only.
+ * unlike VLString there is no \0 kept after the chars: PushBack is a single store,
+ * Size() needs no - 1, and all StaticCapacity inline chars hold text.
+ * the \0 is written by CStr(), just past the end, growing the buffer if it is full.
+ * the class is final, so the compiler can resolve the VLVector virtual calls statically.
+ */
+template <size_t StaticCapacity = START_CAP>
+class VLStringBuf final : public VLVector<char, StaticCapacity>{
+
+    public:
+
+    VLStringBuf(): VLVector<char, StaticCapacity>() {}
+
+    explicit VLStringBuf(const VLStringView str): VLVector<char, StaticCapacity>() {
+        Append(str);
+    }
+
+    /**
+     * appends str in one copy, str may point into this buffer.
+     * @param str
+     */
+    void Append(const VLStringView str) noexcept{
+        const char *src = str.Data();
+        bool aliased = !std::less<const char*>()(src, this->data_)
+                       && std::less<const char*>()(src, this->data_ + this->size_);
+        size_t offset = src - this->data_;
+        char *dest = this->Grow(str.Size());
+        if (aliased){
+            src = this->data_ + offset; // Grow may have moved our buffer
+        }
+        memmove(dest, src, str.Size());
+    }
+
+    VLStringBuf &operator+=(const VLStringView rhs) noexcept{
+        Append(rhs);
+        return *this;
+    }
+
+    VLStringBuf &operator+=(const char rhs) noexcept{
+        this->PushBack(rhs);
+        return *this;
+    }
+
+    /**
+     * writes the \0 after the chars, it stays valid until the next change.
+     * @return the \0 terminated chars
+     */
+    const char* CStr() noexcept{
+        this->ResizeUp(1);
+        this->data_[this->size_] = '\0';
+        return this->data_;
+    }
+
+    VLStringView View() const noexcept{
+        return VLStringView(this->data_, this->size_);
+    }
+
+    operator VLStringView() const noexcept{
+        return View();
+    }
+
+    bool operator==(const VLStringView rhs) const noexcept{
+        return View() == rhs;
+    }
+
+    bool operator!=(const VLStringView rhs) const noexcept{
+        return View() != rhs;
+    }
+
+    uint64_t Hash() const noexcept{
+        return View().Hash();
+    }
+
+    /**
+     * @return a VLString copy of the text
+     */
+    VLString<> ToVLString() const{
+        VLString<> ret;
+        ret.Append(View());
+        return ret;
+    }
+};
+
+/**
+ * hash and equality over anything that converts to VLStringView (VLString, VLStringBuf,
+ * VLCowString, const char*...). both are transparent, so a map keyed by VLString
+ * can be searched with a view without building a string.
+ */
+struct VLStringHash{
+    typedef void is_transparent;
+
+    size_t operator()(const VLStringView str) const noexcept{
+        return str.Hash();
+    }
+};
+
+struct VLStringEqual{
+    typedef void is_transparent;
+
+    bool operator()(const VLStringView lhs, const VLStringView rhs) const noexcept{
+        return lhs == rhs;
+    }
+};
+
+namespace std {
+
+    template<class CharT>
+    struct hash<VLBasicStringView<CharT>> {
+        size_t operator()(const VLBasicStringView<CharT> &str) const noexcept {
+            return str.Hash();
+        }
+    };
+
+    template<class CharT, size_t StaticCapacity>
+    struct hash<VLBasicString<CharT, StaticCapacity>> {
+        size_t operator()(const VLBasicString<CharT, StaticCapacity> &str) const noexcept {
+            return str.Hash();
+        }
+    };
+
+    template<size_t StaticCapacity>
+    struct hash<VLCowString<StaticCapacity>> {
+        size_t operator()(const VLCowString<StaticCapacity> &str) const noexcept {
+            return str.Hash();
+        }
+    };
+
+    template<size_t StaticCapacity>
+    struct hash<VLHashedString<StaticCapacity>> {
+        size_t operator()(const VLHashedString<StaticCapacity> &str) const noexcept {
+            return str.Hash();
+        }
+    };
+
+    template<size_t StaticCapacity>
+    struct hash<VLStringBuf<StaticCapacity>> {
+        size_t operator()(const VLStringBuf<StaticCapacity> &str) const noexcept {
+            return str.Hash();
+        }
+    };
+}
 
+#endif // VL_STRING_H_
@@ -0,0 +1,263 @@
+#ifndef VL_STRING_INTERNER_H_
+#define VL_STRING_INTERNER_H_
+
+#include <mutex>
+#include "vl_string.h"
+
+#define INTERNER_BLOCK_SIZE 4096
+#define INTERNER_START_TABLE 64
+#define INTERNER_NO_HANDLE 0xffffffffu
+#define SHARD_FULL "interner shard is full.\n"
+
+
+/**
+ * deduplicates strings into an arena and hands out 32 bit handles.
+ * the arena is a list of fixed blocks that never move, so the views it returns
+ * stay valid for the life of the interner. every stored string is followed by \0.
+ * two strings interned in the same interner are equal iff their handles are equal.
+ */
+class VLStringInterner{
+
+    public:
+    typedef uint32_t Handle;
+
+    private:
+    struct Entry{
+        const char *data;
+        uint32_t size;
+        uint32_t hash; // low bits of the string hash, saves re-hashing when the table grows
+    };
+
+    VLVector<char*> blocks_;
+    char *cursor_;
+    size_t left_;
+    size_t arena_bytes_;
+    VLVector<Entry> entries_;
+    Handle *table_; // open addressing, holds handle + 1, 0 is an empty slot
+    size_t table_cap_;
+
+    /**
+     * copies str and a \0 into the arena.
+     * strings that do not fit in a block get a block of their own.
+     * @return the arena copy
+     */
+    const char* Store(VLStringView str){
+        size_t need = str.Size() + 1;
+        char *dest;
+        if (need > INTERNER_BLOCK_SIZE / 4){
+            dest = new char[need];
+            blocks_.PushBack(dest);
+        } else {
+            if (need > left_){
+                cursor_ = new char[INTERNER_BLOCK_SIZE];
+                left_ = INTERNER_BLOCK_SIZE;
+                blocks_.PushBack(cursor_);
+            }
+            dest = cursor_;
+            cursor_ += need;
+            left_ -= need;
+        }
+        memcpy(dest, str.Data(), str.Size());
+        dest[str.Size()] = '\0';
+        arena_bytes_ += need;
+        return dest;
+    }
+
+    /**
+     * doubles the table and re-inserts every handle using the cached hashes.
+     */
+    void Rehash(){
+        size_t new_cap = table_cap_ == 0 ? INTERNER_START_TABLE : table_cap_ * 2;
+        Handle *new_table = new Handle[new_cap]();
+        for (size_t handle = 0 ; handle < entries_.Size() ; handle++){
+            size_t ix = entries_[handle].hash & (new_cap - 1);
+            while (new_table[ix] != 0){
+                ix = (ix + 1) & (new_cap - 1);
+            }
+            new_table[ix] = (Handle) handle + 1;
+        }
+        delete[] table_;
+        table_ = new_table;
+        table_cap_ = new_cap;
+    }
+
+    public:
+
+    VLStringInterner(): cursor_(nullptr), left_(0), arena_bytes_(0), table_(nullptr), table_cap_(0) {}
+
+    VLStringInterner(const VLStringInterner &rhs) = delete;
+    VLStringInterner &operator=(const VLStringInterner &rhs) = delete;
+
+    ~VLStringInterner(){
+        for (size_t ix = 0 ; ix < blocks_.Size() ; ix++){
+            delete[] blocks_[ix];
+        }
+        delete[] table_;
+    }
+
+    /**
+     * looks str up using an already computed hash.
+     * @return its handle, or INTERNER_NO_HANDLE
+     */
+    Handle Find(VLStringView str, const uint64_t hash) const noexcept{
+        if (table_cap_ == 0){
+            return INTERNER_NO_HANDLE;
+        }
+        size_t ix = (uint32_t) hash & (table_cap_ - 1);
+        while (table_[ix] != 0){
+            const Entry &entry = entries_.Data()[table_[ix] - 1];
+            if (entry.hash == (uint32_t) hash && entry.size == str.Size()
+                && memcmp(entry.data, str.Data(), str.Size()) == 0){
+                return table_[ix] - 1;
+            }
+            ix = (ix + 1) & (table_cap_ - 1);
+        }
+        return INTERNER_NO_HANDLE;
+    }
+
+    /**
+     * @return handle of str, or INTERNER_NO_HANDLE if it was never interned
+     */
+    Handle Find(VLStringView str) const noexcept{
+        return Find(str, str.Hash());
+    }
+
+    /**
+     * interns str using an already computed hash.
+     * @return the existing handle if str was seen before, a new one otherwise
+     */
+    Handle Intern(VLStringView str, const uint64_t hash){
+        Handle found = Find(str, hash);
+        if (found != INTERNER_NO_HANDLE){
+            return found;
+        }
+        if ((entries_.Size() + 1) * 4 > table_cap_ * 3){
+            Rehash();
+        }
+        Entry entry;
+        entry.data = Store(str);
+        entry.size = (uint32_t) str.Size();
+        entry.hash = (uint32_t) hash;
+        Handle handle = (Handle) entries_.Size();
+        entries_.PushBack(entry);
+        size_t ix = entry.hash & (table_cap_ - 1);
+        while (table_[ix] != 0){
+            ix = (ix + 1) & (table_cap_ - 1);
+        }
+        table_[ix] = handle + 1;
+        return handle;
+    }
+
+    /**
+     * @return the handle of str, interning it first if needed
+     */
+    Handle Intern(VLStringView str){
+        return Intern(str, str.Hash());
+    }
+
+    /**
+     * @param handle returned by Intern
+     * @return a view that stays valid as long as the interner lives
+     */
+    VLStringView View(const Handle handle) const noexcept{
+        const Entry &entry = entries_.Data()[handle];
+        return VLStringView(entry.data, entry.size);
+    }
+
+    /**
+     * @param handle returned by Intern
+     * @return the \0 terminated arena copy
+     */
+    const char* CStr(const Handle handle) const noexcept{
+        return entries_.Data()[handle].data;
+    }
+
+    /**
+     * @return number of distinct strings
+     */
+    size_t Size() const noexcept{
+        return entries_.Size();
+    }
+
+    /**
+     * @return bytes of characters (and \0s) stored in the arena
+     */
+    size_t ArenaBytes() const noexcept{
+        return arena_bytes_;
+    }
+};
+
+
+/**
+ * a thread safe interner made of independent shards, each behind its own mutex.
+ * the shard is picked from the top bits of the hash, so threads interning
+ * different strings rarely wait on each other.
+ * the low ShardBits bits of a handle hold the shard, the rest is the handle inside it.
+ * so a shard holds at most 2^(32 - ShardBits) - 1 strings (268435455 with 4 bits),
+ * the all ones handle is kept for INTERNER_NO_HANDLE. interning past that throws std::length_error.
+ */
+template <size_t ShardBits = 4>
+class VLShardedStringInterner{
+
+    static_assert(ShardBits > 0 && ShardBits < 32, "ShardBits must leave room for the local handle");
+
+    struct Shard{
+        std::mutex lock;
+        VLStringInterner interner;
+    };
+
+    Shard shards_[1 << ShardBits];
+
+    static size_t ShardOf(const uint64_t hash) noexcept{
+        return (size_t) (hash >> (64 - ShardBits));
+    }
+
+    static const size_t SHARD_LIMIT = ((size_t) 1 << (32 - ShardBits)) - 1;
+
+    public:
+    typedef uint32_t Handle;
+
+    Handle Intern(VLStringView str){
+        uint64_t hash = str.Hash();
+        size_t shard = ShardOf(hash);
+        std::lock_guard<std::mutex> guard(shards_[shard].lock);
+        VLStringInterner &interner = shards_[shard].interner;
+        if (interner.Size() >= SHARD_LIMIT && interner.Find(str, hash) == INTERNER_NO_HANDLE){
+            throw std::length_error (SHARD_FULL);
+        }
+        Handle local = interner.Intern(str, hash);
+        return (local << ShardBits) | (Handle) shard;
+    }
+
+    Handle Find(VLStringView str){
+        uint64_t hash = str.Hash();
+        size_t shard = ShardOf(hash);
+        std::lock_guard<std::mutex> guard(shards_[shard].lock);
+        Handle local = shards_[shard].interner.Find(str, hash);
+        if (local == INTERNER_NO_HANDLE){
+            return INTERNER_NO_HANDLE;
+        }
+        return (local << ShardBits) | (Handle) shard;
+    }
+
+    /**
+     * the lock only guards the entry lookup, the view itself points into
+     * arena blocks that never move.
+     */
+    VLStringView View(const Handle handle){
+        Shard &shard = shards_[handle & ((1 << ShardBits) - 1)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.interner.View(handle >> ShardBits);
+    }
+
+    size_t Size(){
+        size_t ret = 0;
+        for (size_t ix = 0 ; ix < ((size_t) 1 << ShardBits) ; ix++){
+            std::lock_guard<std::mutex> guard(shards_[ix].lock);
+            ret += shards_[ix].interner.Size();
+        }
+        return ret;
+    }
+};
+
+#endif // VL_STRING_INTERNER_H_
@@ -0,0 +1,160 @@
+#ifndef VL_SWAR_H_
+#define VL_SWAR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * SIMD within a register: 8 chars are handled at a time as one uint64_t.
+ * every *Bytes function returns a mask with the high bit (0x80) set in each byte
+ * that matches, and no false positives, so the mask can be used directly.
+ */
+
+#define SWAR_ONES 0x0101010101010101ULL
+#define SWAR_LOWS 0x7f7f7f7f7f7f7f7fULL
+#define SWAR_HIGHS 0x8080808080808080ULL
+
+inline uint64_t SwarLoad(const void *p) noexcept {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+inline void SwarStore(void *p, const uint64_t word) noexcept {
+    memcpy(p, &word, sizeof(word));
+}
+
+inline uint64_t SwarBroadcast(const unsigned char c) noexcept {
+    return SWAR_ONES * c;
+}
+
+/**
+ * @return mask of the zero bytes of word
+ */
+inline uint64_t SwarZeroBytes(const uint64_t word) noexcept {
+    return ~(((word & SWAR_LOWS) + SWAR_LOWS) | word) & SWAR_HIGHS;
+}
+
+/**
+ * @return mask of the bytes of word equal to c
+ */
+inline uint64_t SwarEqualBytes(const uint64_t word, const unsigned char c) noexcept {
+    return SwarZeroBytes(word ^ SwarBroadcast(c));
+}
+
+/**
+ * @param n at most 0x80
+ * @return mask of the bytes of word smaller than n
+ */
+inline uint64_t SwarLessBytes(const uint64_t word, const unsigned char n) noexcept {
+    return ~(((word & SWAR_LOWS) + SwarBroadcast(0x80 - n)) | word) & SWAR_HIGHS;
+}
+
+/**
+ * @param lo at least 1
+ * @param hi at most 0x7e
+ * @return mask of the bytes of word in [lo, hi]
+ */
+inline uint64_t SwarRangeBytes(const uint64_t word, const unsigned char lo, const unsigned char hi) noexcept {
+    uint64_t low_bits = word & SWAR_LOWS;
+    uint64_t at_least_lo = low_bits + SwarBroadcast(0x80 - lo);
+    uint64_t above_hi = low_bits + SwarBroadcast(0x7f - hi);
+    return (at_least_lo ^ above_hi) & ~word & SWAR_HIGHS;
+}
+
+inline size_t VLCountTrailingZeros64(const uint64_t word) noexcept {
+#if defined(__GNUC__)
+    return (size_t) __builtin_ctzll(word);
+#else
+    size_t ret = 0;
+    for (uint64_t rest = word ; !(rest & 1) ; rest >>= 1){
+        ret++;
+    }
+    return ret;
+#endif
+}
+
+inline size_t VLCountLeadingZeros64(const uint64_t word) noexcept {
+#if defined(__GNUC__)
+    return (size_t) __builtin_clzll(word);
+#else
+    size_t ret = 0;
+    for (uint64_t rest = word ; !(rest >> 63) ; rest <<= 1){
+        ret++;
+    }
+    return ret;
+#endif
+}
+
+inline size_t VLPopCount64(uint64_t word) noexcept {
+#if defined(__GNUC__)
+    return (size_t) __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (size_t) ((word * SWAR_ONES) >> 56);
+#endif
+}
+
+/**
+ * @param mask non zero
+ * @return index in memory order of the first byte set in mask
+ */
+inline size_t SwarFirstByte(const uint64_t mask) noexcept {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return VLCountLeadingZeros64(mask) / 8;
+#else
+    return VLCountTrailingZeros64(mask) / 8;
+#endif
+}
+
+/**
+ * @param mask non zero
+ * @return index in memory order of the last byte set in mask
+ */
+inline size_t SwarLastByte(const uint64_t mask) noexcept {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return 7 - VLCountTrailingZeros64(mask) / 8;
+#else
+    return 7 - VLCountLeadingZeros64(mask) / 8;
+#endif
+}
+
+/**
+ * for walking every byte of a mask with mask &= mask - 1, which clears the lowest set bit:
+ * the byte of that bit is the first one in memory on little endian, the last one on big endian.
+ * @param mask non zero
+ * @return index in memory order of the byte holding the lowest set bit of mask
+ */
+inline size_t SwarLowestByte(const uint64_t mask) noexcept {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return 7 - VLCountTrailingZeros64(mask) / 8;
+#else
+    return VLCountTrailingZeros64(mask) / 8;
+#endif
+}
+
+/**
+ * @return mask of the ascii white space bytes of word: ' ', \t, \n, \v, \f, \r
+ */
+inline uint64_t SwarSpaceBytes(const uint64_t word) noexcept {
+    return SwarEqualBytes(word, ' ') | SwarRangeBytes(word, '\t', '\r');
+}
+
+/**
+ * @return word with every ascii upper case letter turned to lower case
+ */
+inline uint64_t SwarToLowerAscii(const uint64_t word) noexcept {
+    return word | (SwarRangeBytes(word, 'A', 'Z') >> 2); // 0x80 >> 2 is the 0x20 case bit
+}
+
+/**
+ * @return word with every ascii lower case letter turned to upper case
+ */
+inline uint64_t SwarToUpperAscii(const uint64_t word) noexcept {
+    return word & ~(SwarRangeBytes(word, 'a', 'z') >> 2);
+}
+
+#endif // VL_SWAR_H_
@@ -3,6 +3,9 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <type_traits>
+#include "vl_hash.h"
 
 
 #define REFACTOR_RATIO 1.5
@@ -61,16 +64,26 @@ protected:
         this->data_ = &this->static_data_[0];
         this->cap_ = StaticCapacity;
         DataCopy(tmp, new_size);
-        delete tmp; // delete the pointer holding whats still in the heap
+        delete[] tmp; // delete the pointer holding whats still in the heap
     }
 
     /**
-     * naive implementation.
      * copy the other data directly to this.data
+     * one memcpy when T is trivially copyable, item by item otherwise.
      * @param other_data
      * @param data_len
      */
     void DataCopy(T *other_data, size_t data_len){
+        DataCopy(other_data, data_len, std::is_trivially_copyable<T>());
+    }
+
+    void DataCopy(T *other_data, size_t data_len, std::true_type){
+        if (data_len != 0){
+            memcpy(this->data_, other_data, data_len * sizeof(T));
+        }
+    }
+
+    void DataCopy(T *other_data, size_t data_len, std::false_type){
             for (size_t ix = 0 ; ix < data_len ; ix++){
                 this->data_[ix] = other_data[ix];
             }
@@ -90,12 +103,12 @@ protected:
             MoveToHeap(num_items_to_add);
             return;
         }
-        else if (this->size_ == this->cap_) {
+        else if (new_size > this->cap_) { // with one item this is size_ == cap_
             this->cap_ = CalculateCapC(num_items_to_add);
             T *tmp = this->data_;
             this->data_ = new T[this->cap_];
             DataCopy(tmp, this->size_);
-            delete tmp; // delete the pointer holding whats still in the heap
+            delete[] tmp; // delete the pointer holding whats still in the heap
         }
     }
 
@@ -298,6 +311,19 @@ protected:
 
     }
 
+    /**
+     * adds count items at the end with at most one reallocation.
+     * the new items keep whatever was in the buffer, the caller overwrites them.
+     * @param count
+     * @return iterator to the first new item
+     */
+    Iterator Grow(const size_t count) noexcept {
+        ResizeUp(count);
+        Iterator ret = this->data_ + this->size_;
+        this->size_ += count;
+        return ret;
+    }
+
     /**
     *removes the last item im vector. resize if necessary.
     */
@@ -390,6 +416,9 @@ protected:
          if (this == &rhs){
              return *this;
          }
+         if (this->is_alloc_){
+             delete[] this->data_;
+         }
          this->size_ = rhs.size_;
          this->cap_ = rhs.cap_;
          this->is_alloc_ = rhs.is_alloc_;
@@ -464,4 +493,38 @@ protected:
         return std::reverse_iterator<Iterator>(&this->data_[0]);
     }
 
-};
\ No newline at end of file
+};
+
+/**
+ * types whose bytes are their value, so a vector of them can be hashed as one block of memory.
+ */
+template<class T>
+struct VLIsTriviallyHashable : std::integral_constant<bool,
+        std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value> {};
+
+namespace std {
+
+    /**
+     * hashes the whole data_ block at once when T allows it,
+     * otherwise combines std::hash of every item.
+     */
+    template<class T, size_t StaticCapacity>
+    struct hash<VLVector<T, StaticCapacity>> {
+        size_t operator()(const VLVector<T, StaticCapacity> &vec) const noexcept {
+            return Hash(vec, VLIsTriviallyHashable<T>());
+        }
+
+    private:
+        static size_t Hash(const VLVector<T, StaticCapacity> &vec, std::true_type) noexcept {
+            return VLHashBytes(vec.Data(), vec.Size() * sizeof(T));
+        }
+
+        static size_t Hash(const VLVector<T, StaticCapacity> &vec, std::false_type) noexcept {
+            uint64_t ret = VLHashBytes(nullptr, 0);
+            for (size_t ix = 0 ; ix < vec.Size() ; ix++){
+                ret = VLHashCombine(ret, std::hash<T>()(vec[ix]));
+            }
+            return ret;
+        }
+    };
+}